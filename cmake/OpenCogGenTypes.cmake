@@ -14,7 +14,7 @@
 MACRO(OPENCOG_TYPEINFO_REGEX)
 	# This regular expression is more complex than required
 	# due to cmake's regex engine bugs
-	STRING(REGEX MATCH "^[ 	]*([A-Z0-9_]+)?([ 	]*<-[ 	]*([A-Z0-9_, 	]+))?[ 	]*(\"[A-Za-z]*\")?[ 	]*(//.*)?[ 	]*$" MATCHED "${LINE}")
+	STRING(REGEX MATCH "^[ 	]*([A-Z0-9_]+)?([ 	]*<-[ 	]*([A-Z0-9_, 	]+))?[ 	]*(\"[A-Za-z0-9]*\")?[ 	]*(//.*)?[ 	]*$" MATCHED "${LINE}")
 ENDMACRO(OPENCOG_TYPEINFO_REGEX)
 
 MACRO(OPENCOG_TYPEINFO_SETUP)
@@ -57,3 +57,22 @@
 
 ; Try it!
 (cog-execute! pmany)
+
+; ExecuteAsync does the same, but does not wait. The QueueValue comes
+; back right away, still open; results are added to it as the threads
+; finish them, and it is closed when the last one is in. Asking for
+; the contents of the queue waits until then.
+(define pasync
+	(ExecuteAsync
+		(Set
+			(Meet
+				(TypedVariable (Variable "X") (Type 'Concept))
+				(Inheritance (Variable "X") (Concept "mineral")))
+			(Meet
+				(TypedVariable (Variable "X") (Type 'Concept))
+				(Inheritance (Variable "X") (Concept "plant"))))
+	))
+
+; Try it!
+(define results (cog-execute! pasync))
+(cog-value->list results)
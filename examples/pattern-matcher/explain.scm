@@ -0,0 +1,59 @@
+;
+; explain.scm -- Looking at the query plan.
+;
+; Before a search with several clauses begins, the query planner picks
+; the clause to start with, and the order in which the others are to
+; be grounded. It does this from the number of atoms of each type, and
+; from the size of the incoming sets of the constants in the clauses.
+; The ExplainLink runs a query, and returns the plan that was followed,
+; together with the estimated and the actual number of groundings after
+; each step of it.
+;
+; Plans are made only for queries with three or more clauses; smaller
+; ones are searched just as before.
+;
+(use-modules (opencog) (opencog exec))
+
+; -------------
+; Some people; every other one is rich. Each owns a hundred things,
+; and a few of the things are antiques.
+(define (person n) (Concept (format #f "person ~A" n)))
+(define (item n) (Number n))
+
+(for-each
+	(lambda (p)
+		(if (even? p) (Inheritance (person p) (Concept "rich")))
+		(for-each
+			(lambda (i)
+				(define k (+ (* 100 p) i))
+				(Evaluation (Predicate "owns") (List (person p) (item k)))
+				(if (= 0 (modulo k 150))
+					(Inheritance (item k) (Concept "antique"))))
+			(iota 100)))
+	(iota 100))
+
+; -------------
+; Which rich people own antiques? There are fewer rich people than
+; antiques, but each rich person owns a hundred things, while each
+; antique has just one owner. So the search should start with the
+; antiques, and not with the rich.
+(define rich-antiques
+	(Meet
+		(VariableList
+			(TypedVariable (Variable "$who") (Type 'ConceptNode))
+			(TypedVariable (Variable "$what") (Type 'NumberNode)))
+		(And
+			(Inheritance (Variable "$who") (Concept "rich"))
+			(Evaluation (Predicate "owns")
+				(List (Variable "$who") (Variable "$what")))
+			(Inheritance (Variable "$what") (Concept "antique")))))
+
+(cog-execute! rich-antiques)
+
+; Print the plan. The first column is the step; the second is the
+; number of candidates looked at, at the start (for step zero) or for
+; each grounding so far (for the others). The next two are the number
+; of groundings after the step: estimated, and actually found.
+(display (cog-value-ref (cog-execute! (Explain rich-antiques)) 0))
+
+; The end.
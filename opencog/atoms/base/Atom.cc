@@ -36,6 +36,7 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/truthvalue/CountTruthValue.h>
+#include <opencog/atoms/value/CounterValue.h>
 #include <opencog/atoms/value/FloatValue.h>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -106,10 +107,10 @@ TruthValuePtr Atom::incrementCountTV(double cnt)
 	// Lock so that count updates are atomic!
 	KVP_UNIQUE_LOCK;
 
-	auto pr = _values.find(truth_key());
-	if (_values.end() != pr)
+	ValuePtr pap = _values.get(truth_key());
+	if (pap)
 	{
-		const TruthValuePtr& tvp = TruthValueCast(pr->second);
+		const TruthValuePtr& tvp = TruthValueCast(pap);
 		// tvp might be nullptr, if someone set the TV to something
 		// that is not a truth value. This can happen if the truth
 		// predicate is used directly with setValue().
@@ -124,7 +125,7 @@ TruthValuePtr Atom::incrementCountTV(double cnt)
 
 	TruthValuePtr newTV = CountTruthValue::createTV(mean, conf, cnt);
 
-	_values[truth_key()] = ValueCast(newTV);
+	_values.set(truth_key(), ValueCast(newTV));
 	return newTV;
 }
 
@@ -140,7 +141,7 @@ void Atom::setValue(const Handle& key, const ValuePtr& value)
 	{
 		KVP_UNIQUE_LOCK;
 		if (nullptr != value)
-			_values[truth_key()] = value;
+			_values.set(truth_key(), value);
 		else
 			_values.erase(truth_key());
 	}
@@ -148,7 +149,7 @@ void Atom::setValue(const Handle& key, const ValuePtr& value)
 	{
 		KVP_UNIQUE_LOCK;
 		if (nullptr != value)
-			_values[key] = value;
+			_values.set(key, value);
 		else
 			_values.erase(key);
 	}
@@ -165,36 +166,33 @@ ValuePtr Atom::getValue(const Handle& key) const
     // dereference can return a raw pointer to an object that has been
     // deconstructed.  The AtomSpaceAsyncUTest will hit this, as will
     // the multi-threaded async atom store in the SQL peristance backend.
-    // Furthermore, we must make a copy while holding the lock! Got that?
+    // Furthermore, we must make a copy while the value table can't go
+    // away. The ConcurrentValueMap does this for us, without locking:
+    // writers swap in a new table, and the old one is kept until all
+    // readers are done with it. See ConcurrentValueMap.h
 
     // This is rather irritating, but we fake it for the
     // PredicateNode "*-TruthValueKey-*" because if we don't
     // then load-from-file and load-from-network breaks.
     if ((key != truth_key()) and (*key == *truth_key()))
-    {
-        KVP_SHARED_LOCK;
-        auto pr = _values.find(truth_key());
-        if (_values.end() != pr) return pr->second;
-    }
-    else
-    {
-        KVP_SHARED_LOCK;
-        auto pr = _values.find(key);
-        if (_values.end() != pr) return pr->second;
-    }
+        return _values.get(truth_key());
 
-    return ValuePtr();
+    return _values.get(key);
 }
 
 ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& count)
 {
+	// CounterValues count in place; no need to lock the Atom.
+	ValuePtr cnt = _values.get(key);
+	if (cnt and COUNTER_VALUE == cnt->get_type())
+		return CounterValueCast(cnt)->incrementCount(count);
+
 	KVP_UNIQUE_LOCK;
 
 	// Find the existing value, if it is there.
-	auto pr = _values.find(key);
-	if (_values.end() != pr)
+	ValuePtr pap = _values.get(key);
+	if (pap)
 	{
-		ValuePtr pap = pr->second;
 
 		// Its not a float. Do nothing.
 		if (not pap->is_type(FLOAT_VALUE))
@@ -215,7 +213,9 @@ ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& coun
 		FloatValuePtr fv(FloatValueCast(pap));
 		ValuePtr nv = fv->incrementCount(count);
 
-		_values[key] = nv;
+		// A CounterValue, set while we waited for the lock, is
+		// changed in place.
+		if (nv != pap) _values.set(key, nv);
 		return nv;
 	}
 
@@ -231,20 +231,23 @@ ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& coun
 	else
 		nv = createFloatValue(FLOAT_VALUE, count);
 
-	_values[key] = nv;
+	_values.set(key, nv);
 	return nv;
 }
 
 // Cut-n-paste of the code above.
 ValuePtr Atom::incrementCount(const Handle& key, size_t idx, double count)
 {
+	ValuePtr cnt = _values.get(key);
+	if (cnt and COUNTER_VALUE == cnt->get_type())
+		return CounterValueCast(cnt)->incrementCount(idx, count);
+
 	KVP_UNIQUE_LOCK;
 
 	// Find the existing value, if it is there.
-	auto pr = _values.find(key);
-	if (_values.end() != pr)
+	ValuePtr pap = _values.get(key);
+	if (pap)
 	{
-		ValuePtr pap = pr->second;
 
 		// Its not a float. Do nothing.
 		if (not pap->is_type(FLOAT_VALUE))
@@ -265,7 +268,7 @@ ValuePtr Atom::incrementCount(const Handle& key, size_t idx, double count)
 		FloatValuePtr fv(FloatValueCast(pap));
 		ValuePtr nv = fv->incrementCount(idx, count);
 
-		_values[key] = nv;
+		if (nv != pap) _values.set(key, nv);
 		return nv;
 	}
 
@@ -285,16 +288,15 @@ ValuePtr Atom::incrementCount(const Handle& key, size_t idx, double count)
 	else
 		nv = createFloatValue(FLOAT_VALUE, new_vect);
 
-	_values[key] = nv;
+	_values.set(key, nv);
 	return nv;
 }
 
 HandleSet Atom::getKeys() const
 {
     HandleSet keyset;
-    KVP_SHARED_LOCK;
-    for (const auto& pr : _values)
-        keyset.insert(pr.first);
+    _values.for_each([&](const Handle& k, const ValuePtr&)
+        { keyset.insert(k); });
 
     return keyset;
 }
@@ -304,7 +306,13 @@ void Atom::copyValues(const Handle& other)
     HandleSet okeys(other->getKeys());
     for (const Handle& k: okeys)
     {
-        setValue(k, other->getValue(k));
+        // CounterValues are changed in place; a copy of the Atom
+        // (e.g. in a copy-on-write frame) must not count into the
+        // original. Give it a counter of its own.
+        ValuePtr v(other->getValue(k));
+        if (v and COUNTER_VALUE == v->get_type())
+            v = createCounterValue(FloatValueCast(v)->value());
+        setValue(k, v);
     }
 }
 
@@ -443,7 +451,7 @@ void Atom::drop_incoming_set()
     if (not _use_iset) return;
     INCOMING_UNIQUE_LOCK;
     _use_iset = false;
-    _incoming_set._iset.clear();
+    _incoming_set.clear();
 }
 
 /// Add an atom to the incoming set.
@@ -451,16 +459,17 @@ void Atom::insert_atom(const Handle& a)
 {
     if (not _use_iset) return;
     INCOMING_UNIQUE_LOCK;
+    _incoming_set.insert(a->get_type(), a.operator->(), GET_PTR(a));
+}
 
-    Type at = a->get_type();
-    auto bucket = _incoming_set._iset.find(at);
-    if (bucket == _incoming_set._iset.end())
-    {
-        auto pr = _incoming_set._iset.emplace(
-                   std::make_pair(at, WincomingSet()));
-        bucket = pr.first;
-    }
-    bucket->second.insert(GET_PTR(a));
+/// Add a batch of atoms to the incoming set, taking the lock once.
+/// Used by the bulk loader; `insert_atom()` does one at a time.
+void Atom::insert_atoms(const HandleSeq& hs)
+{
+    if (not _use_iset) return;
+    INCOMING_UNIQUE_LOCK;
+    for (const Handle& a : hs)
+        _incoming_set.insert(a->get_type(), a.operator->(), GET_PTR(a));
 }
 
 /// Remove an atom from the incoming set.
@@ -468,12 +477,7 @@ void Atom::remove_atom(const Handle& a)
 {
     if (not _use_iset) return;
     INCOMING_UNIQUE_LOCK;
-    Type at = a->get_type();
-
-    const auto bucket = _incoming_set._iset.find(at);
-
-    OC_ASSERT(bucket != _incoming_set._iset.end(), "No bucket!");
-    size_t erc = bucket->second.erase(GET_PTR(a));
+    size_t erc = _incoming_set.erase(a->get_type(), a.operator->(), GET_PTR(a));
 
     // std::set is a "true set", in that it either contains something,
     // or it does not.  Therefore, the erase count is either 1 (the
@@ -490,20 +494,8 @@ void Atom::swap_atom(const Handle& old, const Handle& neu)
 {
     if (not _use_iset) return;
     INCOMING_UNIQUE_LOCK;
-
-    Type ot = old->get_type();
-    auto bucket = _incoming_set._iset.find(ot);
-    bucket->second.erase(GET_PTR(old));
-
-    Type nt = neu->get_type();
-    bucket = _incoming_set._iset.find(nt);
-    if (bucket == _incoming_set._iset.end())
-    {
-        auto pr = _incoming_set._iset.emplace(
-                   std::make_pair(nt, WincomingSet()));
-        bucket = pr.first;
-    }
-    bucket->second.insert(GET_PTR(neu));
+    _incoming_set.erase(old->get_type(), old.operator->(), GET_PTR(old));
+    _incoming_set.insert(neu->get_type(), neu.operator->(), GET_PTR(neu));
 }
 
 void Atom::install() {}
@@ -514,12 +506,10 @@ bool Atom::isIncomingSetEmpty(const AtomSpace* as) const
     if (not _use_iset) return true;
     INCOMING_SHARED_LOCK;
 
-    for (const auto& bucket : _incoming_set._iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, { if (not as or as->in_environ(l) or nameserver().isA(_type, FRAME)) return false; })
-    }
-    return true;
+    return not _incoming_set.any([&](const WinkPtr& w) {
+        WEAKLY_DO(l, w, { if (not as or as->in_environ(l) or nameserver().isA(_type, FRAME)) return true; })
+        return false;
+    });
 }
 
 size_t Atom::getIncomingSetSize(const AtomSpace* as) const
@@ -539,46 +529,30 @@ size_t Atom::getIncomingSetSize(const AtomSpace* as) const
 
         size_t cnt = 0;
         INCOMING_SHARED_LOCK;
-        for (const auto& bucket : _incoming_set._iset)
-        {
-            for (const WinkPtr& w : bucket.second)
-                WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; })
-        }
+        _incoming_set.for_each([&](const WinkPtr& w)
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; }));
         return cnt;
     }
 
-    size_t cnt = 0;
     INCOMING_SHARED_LOCK;
-    for (const auto& pr : _incoming_set._iset)
-        cnt += pr.second.size();
-    return cnt;
+    return _incoming_set.size();
 }
 
 /// Add the incoming set for this Atom only to the HandleSet.
 void Atom::getLocalInc(const AtomSpace* as, HandleSet& hs, Type t) const
 {
+    auto add_local = [&](const WinkPtr& w)
+        WEAKLY_DO(l, w, {
+            const Handle& local(as->lookupHandle(l));
+            if (local) hs.insert(local);
+        });
+
     INCOMING_SHARED_LOCK;
     if (NOTYPE != t)
-    {
-        const auto bucket = _incoming_set._iset.find(t);
-        if (bucket == _incoming_set._iset.cend()) return;
-        for (const WinkPtr& w : bucket->second)
-            WEAKLY_DO(l, w, {
-                const Handle& local(as->lookupHandle(l));
-                if (local) hs.insert(local);
-            })
-        return;
-    }
-
-    // If NOTYPE was given, then loop over all possibilities.
-    for (const auto& bucket : _incoming_set._iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, {
-                const Handle& local(as->lookupHandle(l));
-                if (local) hs.insert(local);
-            })
-    }
+        _incoming_set.for_each(t, add_local);
+    else
+        // If NOTYPE was given, then loop over all possibilities.
+        _incoming_set.for_each(add_local);
 }
 
 /// Find all copies of this atom in deeper AtomSpaces, and add the
@@ -643,22 +617,17 @@ IncomingSet Atom::getIncomingSet(const AtomSpace* as) const
         // Prevent update of set while a copy is being made.
         INCOMING_SHARED_LOCK;
         IncomingSet iset;
-        for (const auto& bucket : _incoming_set._iset)
-        {
-            for (const WinkPtr& w : bucket.second)
-                WEAKLY_DO(l, w, { if (as->in_environ(l)) iset.emplace_back(l); })
-        }
+        _incoming_set.for_each([&](const WinkPtr& w)
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) iset.emplace_back(l); }));
         return iset;
     }
 
     // Prevent update of set while a copy is being made.
     INCOMING_SHARED_LOCK;
     IncomingSet iset;
-    for (const auto& bucket : _incoming_set._iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, { iset.emplace_back(l); });
-    }
+    iset.reserve(_incoming_set.size());
+    _incoming_set.for_each([&](const WinkPtr& w)
+        WEAKLY_DO(l, w, { iset.emplace_back(l); }));
     return iset;
 }
 
@@ -685,23 +654,17 @@ IncomingSet Atom::getIncomingSetByType(Type type, const AtomSpace* as) const
 
         // Lock to prevent updates of the set of atoms.
         INCOMING_SHARED_LOCK;
-        const auto bucket = _incoming_set._iset.find(type);
-        if (bucket == _incoming_set._iset.cend()) return empty_set;
-
         IncomingSet result;
-        for (const WinkPtr& w : bucket->second)
-            WEAKLY_DO(l, w, { if (as->in_environ(l)) result.emplace_back(l); })
+        _incoming_set.for_each(type, [&](const WinkPtr& w)
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) result.emplace_back(l); }));
         return result;
     }
 
     // Lock to prevent updates of the set of atoms.
     INCOMING_SHARED_LOCK;
-    const auto bucket = _incoming_set._iset.find(type);
-    if (bucket == _incoming_set._iset.cend()) return empty_set;
-
     IncomingSet result;
-    for (const WinkPtr& w : bucket->second)
-        WEAKLY_DO(l, w, { result.emplace_back(l); })
+    _incoming_set.for_each(type, [&](const WinkPtr& w)
+        WEAKLY_DO(l, w, { result.emplace_back(l); }));
     return result;
 }
 
@@ -723,23 +686,25 @@ size_t Atom::getIncomingSetSizeByType(Type type, const AtomSpace* as) const
         }
 
         INCOMING_SHARED_LOCK;
-        const auto bucket = _incoming_set._iset.find(type);
-        if (bucket == _incoming_set._iset.cend()) return 0;
-
-        for (const WinkPtr& w : bucket->second)
-            WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; })
+        _incoming_set.for_each(type, [&](const WinkPtr& w)
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; }));
         return cnt;
     }
 
     INCOMING_SHARED_LOCK;
-    const auto bucket = _incoming_set._iset.find(type);
-    if (bucket == _incoming_set._iset.cend()) return 0;
-
-    for (const WinkPtr& w : bucket->second)
-        WEAKLY_DO(l, w, { cnt++; })
+    _incoming_set.for_each(type, [&](const WinkPtr& w)
+        WEAKLY_DO(l, w, { cnt++; }));
     return cnt;
 }
 
+size_t Atom::estimateIncomingSetSizeByType(Type type) const
+{
+    if (not _use_iset) return 0;
+
+    INCOMING_SHARED_LOCK;
+    return _incoming_set.size(type);
+}
+
 std::string Atom::id_to_string() const
 {
     std::stringstream ss;
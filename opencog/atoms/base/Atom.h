@@ -41,6 +41,8 @@
 
 #include <opencog/util/empty_string.h>
 #include <opencog/util/sigslot.h>
+#include <opencog/atoms/base/CompactInSet.h>
+#include <opencog/atoms/base/ConcurrentValueMap.h>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/value/Value.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
@@ -56,6 +58,7 @@ namespace opencog
 template<class T>
 struct hashable_weak_ptr : public std::weak_ptr<T>
 {
+	hashable_weak_ptr(void) {}
 	hashable_weak_ptr(std::shared_ptr<T>const& sp) :
 		std::weak_ptr<T>(sp)
 	{
@@ -176,6 +179,13 @@ typedef folly::F14ValueSet<WinkPtr> WincomingSet;
 typedef std::set<WinkPtr, std::owner_less<WinkPtr> > WincomingSet;
 #endif
 
+// The CompactInSet keeps the incoming set in flat arrays, one per
+// Link type, instead of a std::map of std::sets. This cuts the cost
+// of an incoming edge from a 64-byte tree node to a 24-byte array
+// entry, and makes walking the set a linear scan. See CompactInSet.h
+// Comment out the define to go back to std::map<Type, WincomingSet>.
+#define USE_COMPACT_INCOMING_SET 1
+
 /**
  * Atoms are the basic implementational unit in the system that
  * represents nodes and links. In terms of C++ inheritance, Nodes and
@@ -188,10 +198,11 @@ typedef std::set<WinkPtr, std::owner_less<WinkPtr> > WincomingSet;
  * --  8 Bytes Type _type plus 4 bool flags.
  * --  8 Bytes ContentHash _content_hash;
  * --  8 Bytes AtomSpace *_atom_space;
- * -- 48 Bytes std::map<const Handle, ValuePtr> _values;
+ * --  8 Bytes ConcurrentValueMap _values;
  * -- 56 Bytes std::shared_mutex _mtx;
  * -- 48 Bytes std::map<Type, WincomingSet> _incoming_set;
- * Total: 200 Bytes for a base naked Atom.
+ * Total: 160 Bytes for a base naked Atom.
+ * (With USE_COMPACT_INCOMING_SET, the _incoming_set is 24 Bytes.)
  *
  * Node: Additional 32 Bytes for std::string _name + sizeof(chars of string)
  * Link: Additional 24 Bytes for std::vector _outgoing + 16*(_outgoing.size());
@@ -199,13 +210,16 @@ typedef std::set<WinkPtr, std::owner_less<WinkPtr> > WincomingSet;
  *
  * Inserted into the AtomSpace: ?? per hash bucket. I guess 24 or 32
  * Per addition to incoming set: 64 per std::_Rb_tree node
+ *   (With USE_COMPACT_INCOMING_SET: 24 per array entry, plus slack.)
  * Per non-default truth value, e.g. CountTruthValue:
  * -- 24 Bytes std::enable_shared_from_this<Value>
  * --  8 Bytes Type _type plus padding
  * -- 24 Bytes std::vector<double> _value
  * -- 24 Bytes 3*sizeof(double)
- * -- 64 std::_Rb_tree node in the Atom holding the TV
- * Total: 144 Bytes per CountTV (ouch).
+ * Total: 80 Bytes per CountTV.
+ * Plus, for the Atom holding it, a 96 Byte FlatValueMap, with room for
+ *   two Values, and 32 Bytes more for each Value after that. (Before the
+ *   FlatValueMap, it was a 64 Byte std::_Rb_tree node per Value.)
  *
  * A "typical" Link of size 2, held in one other Link, in AtomSpace, holding
  *   a CountTV in it: 496 Bytes.  This is indeed what is measured in real-life
@@ -220,6 +234,7 @@ class Atom
     friend class Frame;           // Needs to call install_atom()
     friend class StateLink;       // Needs to call swap_atom()
     friend class StorageNode;     // Needs to call isAbsent()
+    friend class BulkLoader;      // Needs to call insert_atoms()
 
 protected:
     // Each atomic_flag chews up a byte.
@@ -239,7 +254,8 @@ protected:
     AtomSpace *_atom_space;
 
     /// All of the values on the atom, including the TV.
-    mutable std::map<const Handle, ValuePtr> _values;
+    /// Readable without holding _mtx; writers must hold it.
+    mutable ConcurrentValueMap _values;
 
     // Lock, used to serialize changes.
     // This costs 56 bytes per atom.  Tried using a single, global lock,
@@ -295,7 +311,113 @@ protected:
         // contain a hundred-million atoms, so the solution has to be
         // small. This rules out using a vector to store the
         // buckets (I tried).
+        //
+        // The CompactInSet gets all five, by using small arrays for
+        // small buckets, and open-addressing hash tables for big ones.
+#if USE_COMPACT_INCOMING_SET
+        CompactInSet<WinkPtr> _iset;
+#else
         std::map<Type, WincomingSet> _iset;
+#endif
+
+        // Add the link `key`, of type `t`, with back-pointer `w`.
+        void insert(Type t, const Atom* key, const WinkPtr& w)
+        {
+#if USE_COMPACT_INCOMING_SET
+            _iset.insert(t, key, w);
+#else
+            _iset[t].insert(w);
+#endif
+        }
+
+        // Return the number of entries removed; zero or one.
+        size_t erase(Type t, const Atom* key, const WinkPtr& w)
+        {
+#if USE_COMPACT_INCOMING_SET
+            return _iset.erase(t, key);
+#else
+            auto bucket = _iset.find(t);
+            if (bucket == _iset.end()) return 0;
+            return bucket->second.erase(w);
+#endif
+        }
+
+        template<typename PRED>
+        void erase_if(Type t, PRED pred)
+        {
+#if USE_COMPACT_INCOMING_SET
+            _iset.erase_if(t, pred);
+#else
+            auto bucket = _iset.find(t);
+            if (bucket == _iset.end()) return;
+            for (auto bi = bucket->second.begin(); bi != bucket->second.end();)
+            {
+                if (pred(*bi)) bi = bucket->second.erase(bi);
+                else bi++;
+            }
+#endif
+        }
+
+        template<typename FN>
+        void for_each(FN fn) const
+        {
+#if USE_COMPACT_INCOMING_SET
+            _iset.for_each(fn);
+#else
+            for (const auto& bucket : _iset)
+                for (const WinkPtr& w : bucket.second) fn(w);
+#endif
+        }
+
+        template<typename FN>
+        void for_each(Type t, FN fn) const
+        {
+#if USE_COMPACT_INCOMING_SET
+            _iset.for_each(t, fn);
+#else
+            const auto bucket = _iset.find(t);
+            if (bucket == _iset.cend()) return;
+            for (const WinkPtr& w : bucket->second) fn(w);
+#endif
+        }
+
+        template<typename PRED>
+        bool any(PRED pred) const
+        {
+#if USE_COMPACT_INCOMING_SET
+            return _iset.any(pred);
+#else
+            for (const auto& bucket : _iset)
+                for (const WinkPtr& w : bucket.second)
+                    if (pred(w)) return true;
+            return false;
+#endif
+        }
+
+        size_t size(void) const
+        {
+#if USE_COMPACT_INCOMING_SET
+            return _iset.size();
+#else
+            size_t cnt = 0;
+            for (const auto& pr : _iset)
+                cnt += pr.second.size();
+            return cnt;
+#endif
+        }
+
+        size_t size(Type t) const
+        {
+#if USE_COMPACT_INCOMING_SET
+            return _iset.size(t);
+#else
+            const auto bucket = _iset.find(t);
+            if (bucket == _iset.cend()) return 0;
+            return bucket->second.size();
+#endif
+        }
+
+        void clear(void) { _iset.clear(); }
     };
     InSet _incoming_set;
     void keep_incoming_set();
@@ -303,6 +425,7 @@ protected:
 
     // Insert and remove links from the incoming set.
     void insert_atom(const Handle&);
+    void insert_atoms(const HandleSeq&);
     void remove_atom(const Handle&);
     void swap_atom(const Handle&, const Handle&);
     virtual void install();
@@ -442,7 +565,6 @@ public:
 
     /// Return true if the set of values on this atom isn't empty.
     bool haveValues() const {
-        // I think its safe to call empty() without holding a lock...!?
         return not _values.empty();
     }
 
@@ -476,6 +598,12 @@ public:
     /** Return the size of the incoming set, for the given type. */
     size_t getIncomingSetSizeByType(Type, const AtomSpace* = nullptr) const;
 
+    /** Return the size of the incoming set, for the given type, without
+     *  walking it. This is an estimate, for the query planner: it does
+     *  not check which AtomSpace each link is in, and it may count links
+     *  that are going away. */
+    size_t estimateIncomingSetSizeByType(Type) const;
+
     /** Returns a string representation of the node. */
     virtual std::string to_string(const std::string& indent) const = 0;
     virtual std::string to_short_string(const std::string& indent) const = 0;
@@ -531,11 +659,8 @@ public:
     {
         if (not _use_iset) return result;
         INCOMING_SHARED_LOCK;
-        for (const auto& bucket : _incoming_set._iset)
-        {
-            for (const WinkPtr& w : bucket.second)
-                WEAKLY_DO(h, w, { *result = h; result ++; })
-        }
+        _incoming_set.for_each([&](const WinkPtr& w)
+            WEAKLY_DO(h, w, { *result = h; result ++; }));
         return result;
     }
 
@@ -570,12 +695,8 @@ public:
     {
         if (not _use_iset) return result;
         INCOMING_SHARED_LOCK;
-
-        const auto bucket = _incoming_set._iset.find(type);
-        if (bucket == _incoming_set._iset.cend()) return result;
-
-        for (const WinkPtr& w : bucket->second)
-            WEAKLY_DO(h, w, { *result = h; result ++; })
+        _incoming_set.for_each(type, [&](const WinkPtr& w)
+            WEAKLY_DO(h, w, { *result = h; result ++; }));
         return result;
     }
 };
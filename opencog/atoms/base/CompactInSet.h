@@ -0,0 +1,324 @@
+/*
+ * opencog/atoms/base/CompactInSet.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_COMPACT_IN_SET_H
+#define _OPENCOG_COMPACT_IN_SET_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A compact store for the incoming set of an Atom: the set of Links
+ * that hold the Atom, bucketed by the Link type.
+ *
+ * The std::map<Type, std::set<WinkPtr>> it replaces costs a 64-byte
+ * red-black tree node per edge, plus a map node and a set header per
+ * type. Here, each type gets a bucket holding a flat array of
+ * (key, WinkPtr) entries: 24 bytes per edge, with weak pointers. The
+ * key is the address of the Link, and is used only for identity.
+ *
+ * Low-degree buckets (almost all of them) are small unsorted arrays,
+ * searched linearly. Buckets that grow past `linear_max` entries turn
+ * into open-addressing hash tables, so that hub Atoms, with millions
+ * of incoming Links, still get constant-time insert and remove. They
+ * turn back into arrays when they shrink.
+ *
+ * Not thread-safe; the Atom guards it with its own lock.
+ */
+template<typename W>
+class CompactInSet
+{
+	private:
+		struct Entry
+		{
+			const void* _key;
+			W _wink;
+		};
+
+		struct Bucket
+		{
+			Type _type;
+			uint32_t _tombs;
+			size_t _count;
+
+			// Exactly _count entries, if _count <= linear_max, else
+			// a hash table, with a power-of-two size.
+			std::vector<Entry> _slots;
+
+			bool hashed(void) const { return linear_max < _slots.size(); }
+		};
+
+		// Buckets with up to this many entries are scanned linearly.
+		static constexpr size_t linear_max = 16;
+
+		// Marks a slot whose entry was erased, in a hash table.
+		static const void* tombstone(void)
+		{
+			return reinterpret_cast<const void*>(uintptr_t(1));
+		}
+
+		static bool live(const void* key)
+		{
+			return nullptr != key and tombstone() != key;
+		}
+
+		// A link at a recycled address is a different link; a weak
+		// entry that has expired can be overwritten. Bare pointers
+		// don't expire.
+		template<typename T>
+		static bool stale(const std::weak_ptr<T>& w) { return w.expired(); }
+		template<typename T>
+		static bool stale(const T*) { return false; }
+
+		static size_t slot_of(const void* key, size_t mask)
+		{
+			// Atoms are heap-allocated, so the low bits are zero.
+			return ((uintptr_t(key) >> 4) * 0x9e3779b97f4a7c15ULL >> 20) & mask;
+		}
+
+		std::vector<Bucket> _buckets;
+
+		Bucket* find_bucket(Type t)
+		{
+			for (Bucket& b : _buckets)
+				if (t == b._type) return &b;
+			return nullptr;
+		}
+
+		const Bucket* find_bucket(Type t) const
+		{
+			for (const Bucket& b : _buckets)
+				if (t == b._type) return &b;
+			return nullptr;
+		}
+
+		static void rehash(Bucket& b, size_t cap)
+		{
+			std::vector<Entry> old;
+			old.swap(b._slots);
+			b._tombs = 0;
+
+			if (cap <= linear_max)
+			{
+				b._slots.reserve(b._count);
+				for (Entry& e : old)
+					if (live(e._key)) b._slots.push_back(std::move(e));
+				return;
+			}
+
+			b._slots.resize(cap, Entry{nullptr, W()});
+			size_t mask = cap - 1;
+			for (Entry& e : old)
+			{
+				if (not live(e._key)) continue;
+				size_t i = slot_of(e._key, mask);
+				while (nullptr != b._slots[i]._key) i = (i+1) & mask;
+				b._slots[i] = std::move(e);
+			}
+		}
+
+		// Return the entry for the key, or nullptr.
+		static Entry* lookup(Bucket& b, const void* key)
+		{
+			if (not b.hashed())
+			{
+				for (Entry& e : b._slots)
+					if (key == e._key) return &e;
+				return nullptr;
+			}
+			size_t mask = b._slots.size() - 1;
+			for (size_t i = slot_of(key, mask); ; i = (i+1) & mask)
+			{
+				Entry& e = b._slots[i];
+				if (nullptr == e._key) return nullptr;
+				if (key == e._key) return &e;
+			}
+		}
+
+		void drop_if_empty(Bucket* b)
+		{
+			if (0 < b->_count) return;
+			if (b != &_buckets.back()) std::swap(*b, _buckets.back());
+			_buckets.pop_back();
+		}
+
+		static void erase_entry(Bucket& b, Entry* e)
+		{
+			b._count--;
+			if (b.hashed())
+			{
+				e->_key = tombstone();
+				e->_wink = W();
+				b._tombs++;
+
+				// Go back to a plain array, once small enough.
+				if (b._count <= linear_max / 2)
+					rehash(b, b._count);
+				return;
+			}
+			*e = std::move(b._slots.back());
+			b._slots.pop_back();
+		}
+
+	public:
+		/// Add the Link at address `key`, of type `t`. Returns false,
+		/// if it was already there.
+		bool insert(Type t, const void* key, const W& w)
+		{
+			Bucket* b = find_bucket(t);
+			if (nullptr == b)
+			{
+				_buckets.push_back(Bucket{t, 0, 0, {}});
+				b = &_buckets.back();
+			}
+
+			Entry* e = lookup(*b, key);
+			if (e)
+			{
+				if (not stale(e->_wink)) return false;
+				e->_wink = w;
+				return true;
+			}
+
+			if (not b->hashed())
+			{
+				if (b->_count < linear_max)
+				{
+					b->_slots.push_back(Entry{key, w});
+					b->_count++;
+					return true;
+				}
+				rehash(*b, 4 * linear_max);
+			}
+			else if (8 * (b->_count + b->_tombs + 1) > 7 * b->_slots.size())
+			{
+				// Keep the load under 7/8; double, if mostly live.
+				size_t cap = b->_slots.size();
+				if (2 * b->_count >= cap) cap *= 2;
+				rehash(*b, cap);
+			}
+
+			size_t mask = b->_slots.size() - 1;
+			size_t i = slot_of(key, mask);
+			while (live(b->_slots[i]._key)) i = (i+1) & mask;
+			if (tombstone() == b->_slots[i]._key) b->_tombs--;
+			b->_slots[i] = Entry{key, w};
+			b->_count++;
+			return true;
+		}
+
+		/// Remove the Link at address `key`; return the number removed.
+		size_t erase(Type t, const void* key)
+		{
+			Bucket* b = find_bucket(t);
+			if (nullptr == b) return 0;
+			Entry* e = lookup(*b, key);
+			if (nullptr == e) return 0;
+			erase_entry(*b, e);
+			drop_if_empty(b);
+			return 1;
+		}
+
+		/// Remove the entries of type `t` for which `pred(w)` is true.
+		template<typename PRED>
+		void erase_if(Type t, PRED pred)
+		{
+			Bucket* b = find_bucket(t);
+			if (nullptr == b) return;
+
+			// Erasing moves entries around; find them all first.
+			std::vector<const void*> dead;
+			for (const Entry& e : b->_slots)
+				if (live(e._key) and pred(e._wink)) dead.push_back(e._key);
+			for (const void* key : dead)
+				erase_entry(*b, lookup(*b, key));
+			drop_if_empty(b);
+		}
+
+		/// Call `fn(w)` on every entry.
+		template<typename FN>
+		void for_each(FN fn) const
+		{
+			for (const Bucket& b : _buckets)
+				for (const Entry& e : b._slots)
+					if (live(e._key)) fn(e._wink);
+		}
+
+		/// Return true, if `pred(w)` is true for some entry.
+		template<typename PRED>
+		bool any(PRED pred) const
+		{
+			for (const Bucket& b : _buckets)
+				for (const Entry& e : b._slots)
+					if (live(e._key) and pred(e._wink)) return true;
+			return false;
+		}
+
+		/// Call `fn(w)` on every entry of type `t`.
+		template<typename FN>
+		void for_each(Type t, FN fn) const
+		{
+			const Bucket* b = find_bucket(t);
+			if (nullptr == b) return;
+			for (const Entry& e : b->_slots)
+				if (live(e._key)) fn(e._wink);
+		}
+
+		size_t size(void) const
+		{
+			size_t cnt = 0;
+			for (const Bucket& b : _buckets) cnt += b._count;
+			return cnt;
+		}
+
+		size_t size(Type t) const
+		{
+			const Bucket* b = find_bucket(t);
+			return b ? b->_count : 0;
+		}
+
+		void clear(void) { std::vector<Bucket>().swap(_buckets); }
+
+		/// Heap bytes used, for memory accounting. Does not count the
+		/// weak-pointer control blocks, which belong to the Links.
+		size_t heap_bytes(void) const
+		{
+			size_t bytes = _buckets.capacity() * sizeof(Bucket);
+			for (const Bucket& b : _buckets)
+				bytes += b._slots.capacity() * sizeof(Entry);
+			return bytes;
+		}
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_COMPACT_IN_SET_H
@@ -0,0 +1,192 @@
+/*
+ * opencog/atoms/base/ConcurrentValueMap.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_CONCURRENT_VALUE_MAP_H
+#define _OPENCOG_CONCURRENT_VALUE_MAP_H
+
+#include <atomic>
+#include <vector>
+
+#include <opencog/atoms/base/Epoch.h>
+#include <opencog/atoms/base/FlatValueMap.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * The key-value store on an Atom, readable without taking any locks.
+ *
+ * This is read-copy-update: the map is a FlatValueMap that is never
+ * changed, once published. Writers make a changed copy, and swap it
+ * in; the old copy is retired with Epoch::retire_batched(), so that
+ * writers on different threads do not contend for the retired list,
+ * and it is deleted once the readers that might be looking at it are
+ * done. Until then, it holds on to the keys and Values in it; a
+ * reader might be copying any of them out. The batches are small,
+ * and are handed over at least every millisecond, by a thread that
+ * keeps on writing, so replaced Values do not linger for long.
+ * Retired maps are emptied and kept for reuse by the next write, so
+ * that, once warmed up, setting a Value does not allocate.
+ * Readers just load the pointer, inside an EpochGuard, and so hub
+ * Atoms, whose TruthValues are read from every thread, do not bounce
+ * a lock's cache line between cores. (The one shared write left is
+ * the use-count of the ValuePtr that is handed back.)
+ *
+ * The writer methods must be serialized by the caller; the Atom
+ * does this with its own lock. This is also what keeps read-modify-
+ * write sequences, such as incrementCount(), atomic.
+ *
+ * An Atom with no Values costs just the one pointer.
+ */
+class ConcurrentValueMap
+{
+	private:
+		std::atomic<FlatValueMap*> _map;
+
+		// Emptied maps, ready for reuse, kept per thread. The readers
+		// are done with a map by the time that it lands here.
+		static constexpr size_t spares_max = 16;
+		struct Spares
+		{
+			std::vector<FlatValueMap*> _maps;
+			~Spares()
+			{
+				exited() = true;
+				for (FlatValueMap* m : _maps) delete m;
+			}
+		};
+		static Spares& spares(void)
+		{
+			static thread_local Spares s;
+			return s;
+		}
+		// Trivially destructible, so still usable after spares() is
+		// gone, at thread exit.
+		static bool& exited(void)
+		{
+			static thread_local bool e = false;
+			return e;
+		}
+
+		// The deleter handed to Epoch::retire_batched().
+		static void recycle(void* p)
+		{
+			FlatValueMap* m = static_cast<FlatValueMap*>(p);
+			if (exited() or spares_max <= spares()._maps.size())
+			{
+				delete m;
+				return;
+			}
+			m->reset();
+			spares()._maps.push_back(m);
+		}
+
+		void publish(FlatValueMap* m)
+		{
+			FlatValueMap* old = _map.exchange(m, std::memory_order_acq_rel);
+			if (old) Epoch::retire_batched(old, recycle);
+		}
+
+		// Return a writable copy of the current map, in a spare map,
+		// if there is one.
+		FlatValueMap* copy(void) const
+		{
+			const FlatValueMap* m = _map.load(std::memory_order_relaxed);
+			if (exited() or spares()._maps.empty())
+				return m ? new FlatValueMap(*m) : new FlatValueMap();
+
+			FlatValueMap* nm = spares()._maps.back();
+			spares()._maps.pop_back();
+			if (m) *nm = *m;
+			return nm;
+		}
+
+	public:
+		ConcurrentValueMap(void) : _map(nullptr) {}
+		ConcurrentValueMap(const ConcurrentValueMap&) = delete;
+		ConcurrentValueMap& operator=(const ConcurrentValueMap&) = delete;
+
+		// No reader can be looking: they'd need a Handle to the Atom.
+		~ConcurrentValueMap() { delete _map.load(std::memory_order_relaxed); }
+
+		// ------------------------------------------------------
+		// Lock-free readers.
+
+		/// Return the value for `key`, or nullptr if there isn't one.
+		ValuePtr get(const Handle& key) const
+		{
+			EpochGuard guard;
+			const FlatValueMap* m = _map.load(std::memory_order_acquire);
+			return m ? m->get(key) : ValuePtr();
+		}
+
+		/// Call `fn(key, value)` on every entry of one consistent
+		/// snapshot of the map.
+		template<typename FN>
+		void for_each(FN fn) const
+		{
+			EpochGuard guard;
+			const FlatValueMap* m = _map.load(std::memory_order_acquire);
+			if (m) m->for_each(fn);
+		}
+
+		bool empty(void) const
+		{
+			return nullptr == _map.load(std::memory_order_acquire);
+		}
+
+		// ------------------------------------------------------
+		// Writers. The caller must serialize these.
+
+		/// Set the value for `key`.
+		void set(const Handle& key, const ValuePtr& value)
+		{
+			FlatValueMap* m = copy();
+			m->set(key, value);
+			publish(m);
+		}
+
+		/// Remove the value for `key`, if any.
+		void erase(const Handle& key)
+		{
+			const FlatValueMap* m = _map.load(std::memory_order_relaxed);
+			if (nullptr == m or nullptr == m->get(key)) return;
+			if (1 == m->size()) { publish(nullptr); return; }
+
+			FlatValueMap* nm = copy();
+			nm->erase(key);
+			publish(nm);
+		}
+
+		void clear(void)
+		{
+			if (_map.load(std::memory_order_relaxed)) publish(nullptr);
+		}
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_CONCURRENT_VALUE_MAP_H
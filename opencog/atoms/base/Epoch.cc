@@ -0,0 +1,215 @@
+/*
+ * opencog/atoms/base/Epoch.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <opencog/atoms/base/Epoch.h>
+
+using namespace opencog;
+
+// One record per thread. Records are never freed; when a thread
+// exits, its record is marked free, and is recycled by the next
+// thread that comes along. Thus, the list length is bounded by the
+// maximum number of threads that were ever alive at the same time.
+struct alignas(64) EpochRecord
+{
+	// The global epoch at the time this thread entered its critical
+	// section, or zero, if it is not in one.
+	std::atomic<uint64_t> _epoch;
+	std::atomic<bool> _busy;
+	EpochRecord* _next;
+
+	// Nesting depth. Touched only by the owning thread.
+	size_t _depth;
+};
+
+// Start at one; zero means "not in a critical section".
+static std::atomic<uint64_t> _global_epoch(1);
+static std::atomic<EpochRecord*> _records(nullptr);
+
+// Objects waiting for the readers to finish. Stamps are handed out
+// under the lock, so the list is always sorted by stamp.
+struct Retired
+{
+	uint64_t _stamp;
+	void* _obj;
+	void (*_del)(void*);
+};
+static std::mutex _retired_mtx;
+static std::deque<Retired> _retired;
+
+static EpochRecord* acquire_record(void)
+{
+	for (EpochRecord* r = _records.load(); r; r = r->_next)
+	{
+		bool expect = false;
+		if (r->_busy.compare_exchange_strong(expect, true))
+			return r;
+	}
+
+	EpochRecord* r = new EpochRecord;
+	r->_epoch = 0;
+	r->_busy = true;
+	r->_depth = 0;
+	r->_next = _records.load();
+	while (not _records.compare_exchange_weak(r->_next, r)) {}
+	return r;
+}
+
+// Number of objects a thread collects before handing them over, and
+// the longest that it holds on to them, if it retires any more.
+#define RETIRE_BATCH 32
+#define RETIRE_AGE std::chrono::milliseconds(1)
+
+struct RecordHolder
+{
+	EpochRecord* _rec;
+
+	// Objects from retire_batched(), not yet handed over, and when
+	// the first of them was retired.
+	std::vector<Retired> _batch;
+	std::chrono::steady_clock::time_point _since;
+
+	RecordHolder(void) : _rec(acquire_record()) {}
+	~RecordHolder()
+	{
+		Epoch::flush();
+		_rec->_depth = 0;
+		_rec->_epoch.store(0, std::memory_order_release);
+		_rec->_busy.store(false, std::memory_order_release);
+	}
+};
+
+static thread_local RecordHolder _holder;
+
+void Epoch::enter(void)
+{
+	EpochRecord* r = _holder._rec;
+	if (0 < r->_depth++) return;
+
+	r->_epoch.store(_global_epoch.load(std::memory_order_acquire),
+	                std::memory_order_relaxed);
+
+	// Pairs with the fence in oldest(). Either the reclaimer sees our
+	// epoch, or we see everything that was unlinked before it looked.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void Epoch::leave(void)
+{
+	EpochRecord* r = _holder._rec;
+	if (0 < --r->_depth) return;
+
+	// Everything that we read happens-before the reclaimer sees this.
+	r->_epoch.store(0, std::memory_order_release);
+}
+
+/// Return the stamp below which retired objects can be deleted: the
+/// epoch of the oldest reader that is still in a critical section,
+/// or, if there are none, the current epoch. Anything retired later
+/// gets a stamp no smaller than this. This walks all of the threads,
+/// and so it is not done under the lock.
+static uint64_t oldest(void)
+{
+	uint64_t oldest = _global_epoch.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (EpochRecord* r = _records.load(); r; r = r->_next)
+	{
+		uint64_t e = r->_epoch.load(std::memory_order_acquire);
+		if (0 != e and e < oldest) oldest = e;
+	}
+	return oldest;
+}
+
+/// Move the `n` objects to the shared list, under one stamp, and
+/// take the ones off of it that no reader can still see, all under
+/// one lock. Objects retired here are deleted by the next call, or
+/// by reclaim().
+static void retire_all(const Retired* objs, size_t n)
+{
+	uint64_t old = oldest();
+	std::vector<Retired> ready;
+	{
+		std::lock_guard<std::mutex> lck(_retired_mtx);
+		while (not _retired.empty() and _retired.front()._stamp < old)
+		{
+			ready.push_back(_retired.front());
+			_retired.pop_front();
+		}
+
+		// A reader that loads the advanced epoch also sees the unlink
+		// that preceded this call; such readers cannot hold the object.
+		// Those that might, have an epoch no larger than the stamp.
+		if (0 < n)
+		{
+			uint64_t stamp = _global_epoch.fetch_add(1, std::memory_order_seq_cst);
+			for (size_t i = 0; i < n; i++)
+				_retired.push_back({stamp, objs[i]._obj, objs[i]._del});
+		}
+	}
+
+	// Run the deleters outside of the lock; they might retire more.
+	for (const Retired& r : ready)
+		r._del(r._obj);
+}
+
+void Epoch::retire(void* obj, void (*del)(void*))
+{
+	Retired one{0, obj, del};
+	retire_all(&one, 1);
+	reclaim();
+}
+
+void Epoch::retire_batched(void* obj, void (*del)(void*))
+{
+	std::vector<Retired>& batch = _holder._batch;
+	auto now = std::chrono::steady_clock::now();
+	if (batch.empty()) _holder._since = now;
+	batch.push_back({0, obj, del});
+	if (RETIRE_BATCH <= batch.size() or _holder._since + RETIRE_AGE <= now)
+	{
+		// Deleters may retire more; don't let them see a half-done batch.
+		std::vector<Retired> full;
+		full.swap(batch);
+		retire_all(full.data(), full.size());
+	}
+}
+
+void Epoch::flush(void)
+{
+	std::vector<Retired> all;
+	all.swap(_holder._batch);
+	retire_all(all.data(), all.size());
+	reclaim();
+}
+
+void Epoch::reclaim(void)
+{
+	retire_all(nullptr, 0);
+}
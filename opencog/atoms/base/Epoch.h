@@ -0,0 +1,110 @@
+/*
+ * opencog/atoms/base/Epoch.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_EPOCH_H
+#define _OPENCOG_EPOCH_H
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Epoch-based memory reclamation, for data structures that are read
+ * without taking any locks.
+ *
+ * Readers bracket each lock-free access with an EpochGuard. Writers
+ * (which still serialize amongst themselves, using ordinary locks)
+ * unlink an object so that no new reader can find it, and then hand
+ * it to Epoch::retire(), instead of deleting it. The object is held
+ * until every reader that might have seen it has left its critical
+ * section; only then is it destroyed. The cleanup is done by the
+ * writers, each time that they retire something: an object that a
+ * reader was holding up is deleted by the next retire(), or by an
+ * explicit call to reclaim().
+ *
+ * Entering and leaving a critical section costs a store and a fence
+ * on a thread-private cache line; readers never write to shared
+ * memory, never take a lock, and never run deleters, and so never
+ * contend with one-another, nor with the writers.
+ */
+class Epoch
+{
+	public:
+		/// Enter a read-side critical section. Sections may be nested.
+		static void enter(void);
+
+		/// Leave a read-side critical section.
+		static void leave(void);
+
+		/// Delete `obj` once no reader can be looking at it any more.
+		/// The caller must have already unlinked it.
+		template<typename T>
+		static void retire(T* obj)
+		{
+			retire(obj, [](void* p) { delete static_cast<T*>(p); });
+		}
+
+		/// Call `del(obj)` once no reader can be looking at it any more.
+		static void retire(void* obj, void (*del)(void*));
+
+		/// Like retire(), but cheaper, for objects retired at a high
+		/// rate from many threads: they are collected per thread, and
+		/// handed over to the shared list in batches, so that writers
+		/// do not contend with one-another. The price is that a few
+		/// objects per thread may linger: until the batch fills, or,
+		/// if the thread retires more, until the batch is a millisecond
+		/// old; else until the thread calls flush(), or exits. Once
+		/// handed over, they are deleted by the next retire(), flush()
+		/// or reclaim() from any thread.
+		template<typename T>
+		static void retire_batched(T* obj)
+		{
+			retire_batched(obj, [](void* p) { delete static_cast<T*>(p); });
+		}
+
+		/// Like retire_batched(), but calling `del(obj)`.
+		static void retire_batched(void* obj, void (*del)(void*));
+
+		/// Hand this thread's batch over to the shared list, and
+		/// reclaim.
+		static void flush(void);
+
+		/// Delete all retired objects that no reader can still see.
+		static void reclaim(void);
+};
+
+/// RAII wrapper for Epoch::enter() and Epoch::leave().
+class EpochGuard
+{
+	public:
+		EpochGuard(void) { Epoch::enter(); }
+		~EpochGuard() { Epoch::leave(); }
+		EpochGuard(const EpochGuard&) = delete;
+		EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_EPOCH_H
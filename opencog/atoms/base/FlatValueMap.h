@@ -0,0 +1,243 @@
+/*
+ * opencog/atoms/base/FlatValueMap.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FLAT_VALUE_MAP_H
+#define _OPENCOG_FLAT_VALUE_MAP_H
+
+#include <algorithm>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * The key-value store on an Atom: a map from key Atoms to Values.
+ *
+ * Most Atoms carry only one or two Values (typically, the TruthValue,
+ * and maybe a count), so the first `inline_max` entries are stored in
+ * the FlatValueMap itself; looking one up is a scan of a cache line
+ * or two, and setting one does not allocate. Past that, all of the
+ * entries move to a vector, sorted on the key, and looked up with a
+ * binary search.
+ *
+ * As with std::map<Handle, ValuePtr>, keys are compared by content:
+ * two different C++ objects for the same PredicateNode are the same
+ * key.
+ *
+ * Not thread-safe; the Atom guards it with its own lock.
+ */
+class FlatValueMap
+{
+	private:
+		struct Entry
+		{
+			Handle _key;
+			ValuePtr _value;
+
+			Entry(void) {}
+			Entry(const Handle& k, const ValuePtr& v) : _key(k), _value(v) {}
+
+			// Handle has no move constructor; swap instead of copying,
+			// so that shuffling the vector does not touch refcounts.
+			Entry(Entry&& e) noexcept
+			{ _key.swap(e._key); _value.swap(e._value); }
+			Entry& operator=(Entry&& e) noexcept
+			{ _key.swap(e._key); _value.swap(e._value); return *this; }
+			Entry(const Entry&) = default;
+			Entry& operator=(const Entry&) = default;
+		};
+
+		static constexpr size_t inline_max = 2;
+
+		// Spilled maps up to this size get a pointer-compare scan
+		// before the binary search.
+		static constexpr size_t scan_max = 8;
+
+		// Used if _spill is empty; the live entries come first.
+		Entry _inline[inline_max];
+
+		// If not empty, holds all of the entries, sorted on the key.
+		std::vector<Entry> _spill;
+
+		static bool key_less(const Entry& e, const Handle& key)
+		{
+			return e._key < key;
+		}
+
+		Entry* lookup(const Handle& key)
+		{
+			if (_spill.empty())
+			{
+				// Almost always, the key is the very same Atom.
+				for (Entry& e : _inline)
+					if (e._key == key and e._key) return &e;
+				for (Entry& e : _inline)
+					if (e._key and content_eq(e._key, key)) return &e;
+				return nullptr;
+			}
+			// Comparing pointers is much cheaper than comparing
+			// content, so look for the very same Atom first.
+			if (_spill.size() <= scan_max)
+				for (Entry& e : _spill)
+					if (e._key == key) return &e;
+
+			auto it = std::lower_bound(_spill.begin(), _spill.end(),
+			                           key, key_less);
+			if (it == _spill.end() or key < it->_key) return nullptr;
+			return &*it;
+		}
+
+		const Entry* lookup(const Handle& key) const
+		{
+			return const_cast<FlatValueMap*>(this)->lookup(key);
+		}
+
+	public:
+		/// Return the value for `key`, or nullptr if there isn't one.
+		ValuePtr get(const Handle& key) const
+		{
+			const Entry* e = lookup(key);
+			return e ? e->_value : ValuePtr();
+		}
+
+		/// Return a pointer to the value for `key`, so that it can be
+		/// changed in place, or nullptr if there isn't one.
+		ValuePtr* find(const Handle& key)
+		{
+			Entry* e = lookup(key);
+			return e ? &e->_value : nullptr;
+		}
+
+		/// Set the value for `key`. If there already is a value for
+		/// an equal key, the original key Atom is kept.
+		void set(const Handle& key, const ValuePtr& value)
+		{
+			Entry* e = lookup(key);
+			if (e) { e->_value = value; return; }
+
+			if (_spill.empty())
+			{
+				for (Entry& s : _inline)
+				{
+					if (s._key) continue;
+					s._key = key;
+					s._value = value;
+					return;
+				}
+
+				// Out of room; move everything to the vector.
+				_spill.reserve(2 * inline_max);
+				for (Entry& s : _inline)
+					_spill.emplace_back(std::move(s));
+				std::sort(_spill.begin(), _spill.end(),
+					[](const Entry& a, const Entry& b) { return a._key < b._key; });
+			}
+			auto it = std::lower_bound(_spill.begin(), _spill.end(),
+			                           key, key_less);
+			_spill.insert(it, Entry(key, value));
+		}
+
+		/// Remove the value for `key`, if any.
+		void erase(const Handle& key)
+		{
+			Entry* e = lookup(key);
+			if (nullptr == e) return;
+
+			if (_spill.empty())
+			{
+				// Keep the live entries first.
+				Entry* last = e;
+				for (Entry& o : _inline)
+					if (o._key) last = &o;
+				if (last != e) *e = std::move(*last);
+				*last = Entry();
+				return;
+			}
+			_spill.erase(_spill.begin() + (e - _spill.data()));
+
+			// Back to inline, once small enough.
+			if (_spill.size() <= inline_max)
+			{
+				for (size_t i = 0; i < _spill.size(); i++)
+					_inline[i] = std::move(_spill[i]);
+				std::vector<Entry>().swap(_spill);
+			}
+		}
+
+		/// Call `fn(key, value)` on every entry.
+		template<typename FN>
+		void for_each(FN fn) const
+		{
+			if (not _spill.empty())
+			{
+				for (const Entry& e : _spill) fn(e._key, e._value);
+				return;
+			}
+			for (const Entry& e : _inline)
+				if (e._key) fn(e._key, e._value);
+		}
+
+		size_t size(void) const
+		{
+			if (not _spill.empty()) return _spill.size();
+			size_t cnt = 0;
+			for (const Entry& e : _inline)
+				if (e._key) cnt++;
+			return cnt;
+		}
+
+		bool empty(void) const
+		{
+			return _spill.empty() and nullptr == _inline[0]._key;
+		}
+
+		void clear(void)
+		{
+			for (Entry& e : _inline) e = Entry();
+			std::vector<Entry>().swap(_spill);
+		}
+
+		/// Like clear(), but keep the storage, for reuse.
+		void reset(void)
+		{
+			for (Entry& e : _inline) e = Entry();
+			_spill.clear();
+		}
+
+		/// Heap bytes used by the map itself, not counting the keys
+		/// and Values, for memory accounting.
+		size_t heap_bytes(void) const
+		{
+			return _spill.capacity() * sizeof(Entry);
+		}
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_FLAT_VALUE_MAP_H
@@ -28,6 +28,7 @@
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/base/hash.h>
 
 #include "Link.h"
 
@@ -170,6 +171,7 @@ ContentHash Link::compute_hash() const
 {
 	// The nameserver().getTypeHash() returns hash of the type name
 	// string, and is thus independent of all other type declarations.
+#ifdef CLASSIC_ATOM_HASH
 	// 1<<44 - 377 is prime
 	ContentHash hsh = ((1ULL<<44) - 377) * nameserver().getTypeHash(get_type());
 
@@ -184,6 +186,14 @@ ContentHash Link::compute_hash() const
 		hsh *= 0xc4ceb9fe1a85ec53L;
 		hsh ^= hsh >> 33;
 	}
+#else
+	// One 128-bit multiply per child; then the arity, as a string
+	// hash finishes with the length.
+	ContentHash hsh = nameserver().getTypeHash(get_type());
+	for (const Handle& h: _outgoing)
+		hsh = hash_fold(hsh, h->get_hash()); // recursive!
+	hsh = hash_fold(hsh, _outgoing.size());
+#endif
 
 	// Links will always have the MSB set.
 	ContentHash mask = ((ContentHash) 1ULL) << (8*sizeof(ContentHash) - 1);
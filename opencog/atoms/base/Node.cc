@@ -24,6 +24,7 @@
 #include <iomanip>
 
 #include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/hash.h>
 
 #include "Node.h"
 
@@ -173,12 +174,19 @@ bool Node::operator<(const Atom& other) const
 
 ContentHash Node::compute_hash() const
 {
+#ifdef CLASSIC_ATOM_HASH
 	ContentHash hsh = std::hash<std::string>()(get_name());
 
 	// 1<<43 - 369 is a prime number.
 	// The nameserver().getTypeHash() returns hash of the type string name,
 	// and is thus independent of other types in the tree.
 	hsh += (hsh<<5) + ((1ULL<<43)-369) * nameserver().getTypeHash(get_type());
+#else
+	// The hash of the type name seeds the hash of the node name.
+	const std::string& name(get_name());
+	ContentHash hsh = wyhash(name.data(), name.size(),
+	                         nameserver().getTypeHash(get_type()));
+#endif
 
 	// Nodes will never have the MSB set.
 	ContentHash mask = ~(((ContentHash) 1ULL) << (8*sizeof(ContentHash) - 1));
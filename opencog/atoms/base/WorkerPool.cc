@@ -0,0 +1,200 @@
+/*
+ * opencog/atoms/base/WorkerPool.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+#include <opencog/util/platform.h>
+#include <opencog/atoms/base/WorkerPool.h>
+
+using namespace opencog;
+
+// One call to run(). It lives on the caller's stack; the caller does
+// not return until `pending` drops to zero, and so no ticket can
+// outlive it.
+struct WorkerPool::Job
+{
+	const std::function<void(size_t)>* fn;
+	size_t pending;
+	std::exception_ptr err;
+};
+
+// How long a thread kept for a large run() waits for more work,
+// before it exits.
+static const auto IDLE_TIMEOUT = std::chrono::seconds(10);
+
+// Set on the threads working on a run(), the caller included, for
+// the duration of it. Not set for posted tasks: those are not part
+// of any run(), and can make one of their own.
+static thread_local bool t_busy = false;
+
+WorkerPool::WorkerPool(void) :
+	_nthreads(0), _idle(0)
+{
+	_floor = std::max(1U, std::thread::hardware_concurrency());
+	_keep = _floor;
+}
+
+bool WorkerPool::busy(void)
+{
+	return t_busy;
+}
+
+size_t WorkerPool::size(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _nthreads;
+}
+
+// Call with the lock held.
+void WorkerPool::spawn(void)
+{
+	std::thread(&WorkerPool::worker, this).detach();
+	_nthreads++;
+}
+
+void WorkerPool::worker(void)
+{
+	set_thread_name("atoms:pool");
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (true)
+	{
+		_idle++;
+		bool woke = _work_cv.wait_for(lck, IDLE_TIMEOUT,
+			[&]() { return not _queue.empty(); });
+		_idle--;
+
+		// Nothing to do for a while; a large run() is over.
+		if (not woke)
+		{
+			if (_floor < _keep)
+			{
+				_keep--;
+				_nthreads--;
+				return;
+			}
+			continue;
+		}
+
+		Ticket t = std::move(_queue.front());
+		_queue.pop_front();
+		lck.unlock();
+
+		if (nullptr == t.job)
+		{
+			try { t.task(); }
+			catch (...) {}
+			set_thread_name("atoms:pool");
+
+			// Whatever the task held on to goes now, and not later,
+			// under the lock.
+			t.task = nullptr;
+			lck.lock();
+		}
+		else
+		{
+			std::exception_ptr err;
+			t_busy = true;
+			try { (*t.job->fn)(t.idx); }
+			catch (...) { err = std::current_exception(); }
+			t_busy = false;
+
+			lck.lock();
+			if (err and not t.job->err) t.job->err = err;
+			if (0 == --t.job->pending) _done_cv.notify_all();
+		}
+
+		// Threads started for a burst of posts go away again.
+		if (_keep < _nthreads and _queue.empty())
+		{
+			_nthreads--;
+			return;
+		}
+	}
+}
+
+void WorkerPool::run(size_t n, const std::function<void(size_t)>& fn)
+{
+	if (n <= 1 or t_busy)
+	{
+		fn(0);
+		return;
+	}
+
+	Job job;
+	job.fn = &fn;
+	job.pending = n - 1;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		for (size_t i = 1; i < n; i++)
+			_queue.push_back({&job, i, nullptr});
+		_keep = std::max(_keep, n - 1);
+		while (_nthreads < n - 1) spawn();
+	}
+	_work_cv.notify_all();
+
+	t_busy = true;
+	std::exception_ptr err;
+	try { fn(0); }
+	catch (...) { err = std::current_exception(); }
+	t_busy = false;
+
+	// All the work has been taken; drop the tickets that no thread
+	// got to, and wait for the rest.
+	std::unique_lock<std::mutex> lck(_mtx);
+	for (auto it = _queue.begin(); it != _queue.end(); )
+	{
+		if (&job == it->job)
+		{
+			it = _queue.erase(it);
+			job.pending--;
+		}
+		else it++;
+	}
+	_done_cv.wait(lck, [&]() { return 0 == job.pending; });
+
+	if (not err) err = job.err;
+	if (err) std::rethrow_exception(err);
+}
+
+void WorkerPool::post(std::function<void(void)> task)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_queue.push_back({nullptr, 0, std::move(task)});
+
+		// Each idle thread takes one ticket; if there are more tickets
+		// than that, this one would have to wait for a busy thread.
+		if (_idle < _queue.size()) spawn();
+	}
+	_work_cv.notify_one();
+}
+
+WorkerPool& opencog::workerpool(void)
+{
+	// Leaked on purpose: the threads are detached, and may still be
+	// waiting on it while the statics are being destroyed.
+	static WorkerPool* pool = new WorkerPool();
+	return *pool;
+}
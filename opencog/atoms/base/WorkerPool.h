@@ -0,0 +1,118 @@
+/*
+ * opencog/atoms/base/WorkerPool.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_WORKER_POOL_H
+#define _OPENCOG_WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A process-wide pool of threads, kept around between uses, so that
+ * going parallel costs a wakeup, and not a thread creation.
+ *
+ * `run(n, fn)` calls `fn(0)` on the calling thread, and queues
+ * `fn(1)` ... `fn(n-1)` for the pool. The `fn` is expected to be a
+ * loop that takes work from some shared source, until there is none
+ * left; so, once the caller's own `fn(0)` returns, all of the work
+ * has been handed out, and any ticket not yet started is dropped,
+ * instead of waking a thread for nothing. `run()` returns once the
+ * tickets that did start are done. If any of them threw, the first
+ * exception is rethrown on the calling thread.
+ *
+ * A `run()` from inside another one (from any of its `fn(i)`) just
+ * calls `fn(0)`: nested parallelism only adds overhead. A `run()` from
+ * a posted task is not nested, and goes parallel as usual; it cannot
+ * deadlock the pool, as tickets that no thread gets to are dropped,
+ * and not waited on.
+ *
+ * `post(task)` is for work that is not waited on: the task is queued,
+ * and `post()` returns at once. Posted tasks may run for a long time,
+ * or wait on one another (the branches of a ParallelLink may sleep, or
+ * poll for what the others did); so a posted task never waits for a
+ * busy thread: if none is idle, another one is started for it.
+ *
+ * Threads are created as needed. Once idle, the pool keeps as many of
+ * them as the hardware has cores, or the largest recent `n` asked of
+ * `run()`, less one, whichever is more; the rest exit. The threads
+ * kept for a large `run()` exit one by one, once they have been idle
+ * for a while, so that it does not keep them around forever.
+ */
+class WorkerPool
+{
+	private:
+		struct Job;
+		struct Ticket
+		{
+			Job* job;
+			size_t idx;
+			std::function<void(void)> task;
+		};
+
+		std::mutex _mtx;
+		std::condition_variable _work_cv;
+		std::condition_variable _done_cv;
+		std::deque<Ticket> _queue;
+		size_t _nthreads;
+		size_t _idle;
+		size_t _keep;
+		size_t _floor;
+
+		void worker(void);
+		void spawn(void);
+
+	public:
+		WorkerPool(void);
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/// Run `fn(0)` ... `fn(n-1)`, as described above.
+		void run(size_t n, const std::function<void(size_t)>& fn);
+
+		/// Run `task` on a pool thread, and return without waiting.
+		/// The task must catch its own exceptions; any that escape
+		/// are dropped.
+		void post(std::function<void(void)> task);
+
+		/// True if the calling thread is inside of a `run()`.
+		static bool busy(void);
+
+		/// The number of threads in the pool, so far.
+		size_t size(void);
+};
+
+/// The shared pool. It is never destroyed; its threads are detached,
+/// so that it is safe to use from static destructors.
+WorkerPool& workerpool(void);
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_WORKER_POOL_H
@@ -1,6 +1,8 @@
 #ifndef _OPENCOG_HASH_H
 #define _OPENCOG_HASH_H
 
+#include <cstring>
+
 #include <opencog/atoms/base/Handle.h>
 
 namespace opencog {
@@ -61,6 +63,103 @@ typename std::enable_if<sizeof(ContentHash) < sizeof(T), ContentHash>::type fnv1
 	return hval;
 }
 
+// wyhash, by Wang Yi; public domain (The Unlicense). This is the
+// "final4" version, from https://github.com/wangyi-fudan/wyhash
+// It reads a string eight bytes at a time, and mixes with a single
+// 64x64->128 bit multiply per 16 bytes, so that hashing a long Node
+// name costs a fraction of what std::hash<std::string> does, and
+// with better dispersion.
+namespace wy {
+
+static const uint64_t P0 = 0x2d358dccaa6c78a5ULL;
+static const uint64_t P1 = 0x8bb84b93962eacc9ULL;
+static const uint64_t P2 = 0x4b33a62ed433d4a3ULL;
+static const uint64_t P3 = 0x4d5a2da51de1aa47ULL;
+
+/// Multiply, and fold the 128-bit product back onto itself.
+static inline uint64_t mix(uint64_t a, uint64_t b)
+{
+	__uint128_t r = a;
+	r *= b;
+	return (uint64_t) r ^ (uint64_t) (r >> 64);
+}
+
+static inline uint64_t r8(const uint8_t* p)
+{
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+static inline uint64_t r4(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+// One to three bytes.
+static inline uint64_t r3(const uint8_t* p, size_t k)
+{
+	return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace wy
+
+static inline uint64_t wyhash(const void* key, size_t len, uint64_t seed)
+{
+	const uint8_t* p = (const uint8_t*) key;
+	seed ^= wy::mix(seed ^ wy::P0, wy::P1);
+	uint64_t a, b;
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			a = (wy::r4(p) << 32) | wy::r4(p + ((len >> 3) << 2));
+			b = (wy::r4(p + len - 4) << 32) |
+			     wy::r4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (len > 0) { a = wy::r3(p, len); b = 0; }
+		else a = b = 0;
+	}
+	else
+	{
+		size_t i = len;
+		if (i > 48)
+		{
+			uint64_t see1 = seed, see2 = seed;
+			do
+			{
+				seed = wy::mix(wy::r8(p) ^ wy::P1, wy::r8(p + 8) ^ seed);
+				see1 = wy::mix(wy::r8(p + 16) ^ wy::P2, wy::r8(p + 24) ^ see1);
+				see2 = wy::mix(wy::r8(p + 32) ^ wy::P3, wy::r8(p + 40) ^ see2);
+				p += 48; i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = wy::mix(wy::r8(p) ^ wy::P1, wy::r8(p + 8) ^ seed);
+			i -= 16; p += 16;
+		}
+		a = wy::r8(p + i - 16);
+		b = wy::r8(p + i - 8);
+	}
+	__uint128_t r = a ^ wy::P1;
+	r *= b ^ seed;
+	a = (uint64_t) r;
+	b = (uint64_t) (r >> 64);
+	return wy::mix(a ^ wy::P0 ^ len, b ^ wy::P1);
+}
+
+/// Fold `h` into the running hash `hsh`. This is order-sensitive:
+/// folding in A and then B does not give the same as B and then A.
+/// Every bit of either one reaches every bit of the result.
+static inline ContentHash hash_fold(ContentHash hsh, ContentHash h)
+{
+	return wy::mix(hsh ^ wy::P0, h ^ wy::P1);
+}
+
 } // namespace opencog
 
 #endif // _OPENCOG_HASH_H
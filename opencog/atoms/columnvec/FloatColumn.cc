@@ -62,7 +62,7 @@ ValuePtr FloatColumn::do_handle_loop(AtomSpace* as, bool silent,
 				vp->size());
 
 		if (vp->is_type(FLOAT_VALUE))
-			dvec.push_back(FloatValueCast(vp)->value()[0]);
+			dvec.push_back(FloatValueCast(vp)->span()[0]);
 		else if (vp->is_type(NUMBER_NODE))
 			dvec.push_back(NumberNodeCast(vp)->get_value());
 		else
@@ -117,7 +117,7 @@ ValuePtr FloatColumn::do_execute(AtomSpace* as, bool silent)
 						vp->size());
 
 				if (vp->is_type(FLOAT_VALUE))
-					dvec.push_back(FloatValueCast(vp)->value()[0]);
+					dvec.push_back(FloatValueCast(vp)->span()[0]);
 				else if (vp->is_type(NUMBER_NODE))
 					dvec.push_back(NumberNodeCast(vp)->get_value());
 				else
@@ -104,7 +104,7 @@ ValuePtr TransposeColumn::do_value_loop(AtomSpace* as, bool silent,
 			// the LinkValues...
 			if (vp->is_type(FLOAT_VALUE))
 			{
-				const std::vector<double>& vals = FloatValueCast(vp)->value();
+				FloatSpan vals(FloatValueCast(vp)->span());
 				for (double d : vals)
 					vcols.push_back(createFloatValue(d));
 			}
@@ -161,7 +161,7 @@ ValuePtr TransposeColumn::do_value_loop(AtomSpace* as, bool silent,
 		// many columns there are, and what their types should be.
 		if (vp->is_type(FLOAT_VALUE))
 		{
-			const std::vector<double>& vals = FloatValueCast(vp)->value();
+			FloatSpan vals(FloatValueCast(vp)->span());
 			CHKSZ(vals);
 			for (size_t i=0; i<ncols; i++)
 				FloatValueCast(vcols[i]) -> _value.push_back(vals[i]);
@@ -238,7 +238,7 @@ ValuePtr TransposeColumn::do_direct_loop(AtomSpace* as, bool silent,
 	{
 		if (vp->is_type(FLOAT_VALUE))
 		{
-			const std::vector<double>& vals = FloatValueCast(vp)->value();
+			FloatSpan vals(FloatValueCast(vp)->span());
 			CHKSZ(vals);
 			for (size_t i=0; i< ncols; i++)
 				LinkValueCast(vcols[i]) -> _value.push_back(
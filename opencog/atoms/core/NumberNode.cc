@@ -10,6 +10,8 @@
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 
+#include <opencog/atoms/value/CompactArith.h>
+#include <opencog/atoms/value/FloatKernels.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include "NumberNode.h"
 
@@ -149,6 +151,12 @@ ValuePtr opencog::plus(double f, const ValuePtr& vj, bool silent)
 {
 	Type vjtype = vj->get_type();
 
+	if (is_compact(vjtype))
+	{
+		ValuePtr vp(compact_arith(ARITH_PLUS, f, FloatValueCast(vj)));
+		if (vp) return vp;
+	}
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vjtype)
 		return plus(f, NumberNodeCast(vj));
@@ -167,6 +175,12 @@ ValuePtr opencog::minus(double f, const ValuePtr& vj, bool silent)
 {
 	Type vjtype = vj->get_type();
 
+	if (is_compact(vjtype))
+	{
+		ValuePtr vp(compact_arith(ARITH_MINUS, f, FloatValueCast(vj)));
+		if (vp) return vp;
+	}
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vjtype)
 		return minus(f, NumberNodeCast(vj));
@@ -185,6 +199,12 @@ ValuePtr opencog::times(double f, const ValuePtr& vj, bool silent)
 {
 	Type vjtype = vj->get_type();
 
+	if (is_compact(vjtype))
+	{
+		ValuePtr vp(compact_arith(ARITH_TIMES, f, FloatValueCast(vj)));
+		if (vp) return vp;
+	}
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vjtype)
 		return times(f, NumberNodeCast(vj));
@@ -203,6 +223,12 @@ ValuePtr opencog::divide(double f, const ValuePtr& vj, bool silent)
 {
 	Type vjtype = vj->get_type();
 
+	if (is_compact(vjtype))
+	{
+		ValuePtr vp(compact_arith(ARITH_DIVIDE, f, FloatValueCast(vj)));
+		if (vp) return vp;
+	}
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vjtype)
 		return divide(f, NumberNodeCast(vj));
@@ -218,12 +244,43 @@ ValuePtr opencog::divide(double f, const ValuePtr& vj, bool silent)
 
 // ============================================================
 
+/// Float32Values and UInt32Values, with each other, or with a single
+/// number, are done in their own precision; see CompactArith.h.
+/// Returns nullptr for anything else.
+static ValuePtr compact(ArithOp op, const ValuePtr& vi, const ValuePtr& vj)
+{
+	Type vitype = vi->get_type();
+	Type vjtype = vj->get_type();
+	if (not is_compact(vitype) and not is_compact(vjtype)) return nullptr;
+
+	if (NUMBER_NODE == vitype)
+	{
+		NumberNodePtr nn(NumberNodeCast(vi));
+		if (1 != nn->size()) return nullptr;
+		return compact_arith(op, nn->get_value(), FloatValueCast(vj));
+	}
+	if (NUMBER_NODE == vjtype)
+	{
+		NumberNodePtr nn(NumberNodeCast(vj));
+		if (1 != nn->size()) return nullptr;
+		return compact_arith(op, FloatValueCast(vi), nn->get_value());
+	}
+
+	if (not nameserver().isA(vitype, FLOAT_VALUE) or
+	    not nameserver().isA(vjtype, FLOAT_VALUE))
+		return nullptr;
+	return compact_arith(op, FloatValueCast(vi), FloatValueCast(vj));
+}
+
 /// Vector (point-wise) addition
 ValuePtr opencog::plus(const ValuePtr& vi, const ValuePtr& vj, bool silent)
 {
 	Type vitype = vi->get_type();
 	Type vjtype = vj->get_type();
 
+	ValuePtr vc(compact(ARITH_PLUS, vi, vj));
+	if (vc) return vc;
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vitype and NUMBER_NODE == vjtype)
 		return plus(NumberNodeCast(vi), NumberNodeCast(vj));
@@ -260,6 +317,9 @@ ValuePtr opencog::minus(const ValuePtr& vi, const ValuePtr& vj, bool silent)
 	Type vitype = vi->get_type();
 	Type vjtype = vj->get_type();
 
+	ValuePtr vc(compact(ARITH_MINUS, vi, vj));
+	if (vc) return vc;
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vitype and NUMBER_NODE == vjtype)
 		return minus(NumberNodeCast(vi), NumberNodeCast(vj));
@@ -295,6 +355,9 @@ ValuePtr opencog::times(const ValuePtr& vi, const ValuePtr& vj, bool silent)
 	Type vitype = vi->get_type();
 	Type vjtype = vj->get_type();
 
+	ValuePtr vc(compact(ARITH_TIMES, vi, vj));
+	if (vc) return vc;
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vitype and NUMBER_NODE == vjtype)
 		return times(NumberNodeCast(vi), NumberNodeCast(vj));
@@ -320,6 +383,9 @@ ValuePtr opencog::divide(const ValuePtr& vi, const ValuePtr& vj, bool silent)
 	Type vitype = vi->get_type();
 	Type vjtype = vj->get_type();
 
+	ValuePtr vc(compact(ARITH_DIVIDE, vi, vj));
+	if (vc) return vc;
+
 	// Are they numbers? If so, perform vector (pointwise) addition.
 	if (NUMBER_NODE == vitype and NUMBER_NODE == vjtype)
 		return divide(NumberNodeCast(vi), NumberNodeCast(vj));
@@ -342,4 +408,63 @@ ValuePtr opencog::divide(const ValuePtr& vi, const ValuePtr& vj, bool silent)
 
 // ============================================================
 
+/// The numbers held by a NumberNode or a FloatValue, if any. Compact
+/// values are left to compact_arith(), which keeps their precision.
+static bool numbers(const ValuePtr& vp, bool& is_node, FloatSpan& nums)
+{
+	Type t = vp->get_type();
+	is_node = (NUMBER_NODE == t);
+	if (is_node)
+		nums = NumberNodeCast(vp)->value();
+	else if (is_compact(t))
+		return false;
+	else if (nameserver().isA(t, FLOAT_VALUE))
+		nums = FloatValueCast(vp)->span();
+	else
+		return false;
+	return true;
+}
+
+/// Fused a*b + c, made in one pass over the vectors, without making a
+/// vector for the product. This gives the same result as
+/// plus(times(a, b), c), but only covers the common shapes: `c` is a
+/// vector, and `a` and `b` are either that long, or scalars. For any
+/// other shape, it returns nullptr, and plus() and times() must be
+/// used instead.
+ValuePtr opencog::times_plus(const ValuePtr& va, const ValuePtr& vb,
+                             const ValuePtr& vc)
+{
+	// A stream sampled twice would give two different vectors.
+	if (va == vb or va == vc or vb == vc) return nullptr;
+
+	bool na, nb, nc;
+	FloatSpan a, b, c;
+	if (not numbers(va, na, a) or not numbers(vb, nb, b) or
+	    not numbers(vc, nc, c))
+		return nullptr;
+
+	size_t len = c.size();
+	size_t lena = a.size();
+	size_t lenb = b.size();
+	if (len < 2) return nullptr;
+	if ((1 != lena and len != lena) or (1 != lenb and len != lenb))
+		return nullptr;
+
+	std::vector<double> sum(len);
+	if (1 == lena and 1 == lenb)
+		vec_add_scalar(sum.data(), a[0] * b[0], c.data(), len);
+	else if (1 == lena)
+		vec_scale_add(sum.data(), a[0], b.data(), c.data(), len);
+	else if (1 == lenb)
+		vec_scale_add(sum.data(), b[0], a.data(), c.data(), len);
+	else
+		vec_mul_add(sum.data(), a.data(), b.data(), c.data(), len);
+
+	if (na and nb and nc)
+		return createNumberNode(std::move(sum));
+	return createFloatValue(std::move(sum));
+}
+
+// ============================================================
+
 DEFINE_NODE_FACTORY(NumberNode, NUMBER_NODE)
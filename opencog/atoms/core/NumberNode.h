@@ -136,35 +136,38 @@ ValuePtr divide(const NumberNodePtr& fvpa, const NumberNodePtr& fvpb) {
 
 inline
 ValuePtr plus(const FloatValuePtr& fvpa, const NumberNodePtr& fvpb) {
-	return createFloatValue(plus(fvpa->value(), fvpb->value())); }
+	return createFloatValue(plus(fvpa->span(), fvpb->value())); }
 inline
 ValuePtr minus(const FloatValuePtr& fvpa, const NumberNodePtr& fvpb) {
-	return createFloatValue(minus(fvpa->value(), fvpb->value())); }
+	return createFloatValue(minus(fvpa->span(), fvpb->value())); }
 inline
 ValuePtr times(const FloatValuePtr& fvpa, const NumberNodePtr& fvpb) {
-	return createFloatValue(times(fvpa->value(), fvpb->value())); }
+	return createFloatValue(times(fvpa->span(), fvpb->value())); }
 inline
 ValuePtr divide(const FloatValuePtr& fvpa, const NumberNodePtr& fvpb) {
-	return createFloatValue(divide(fvpa->value(), fvpb->value())); }
+	return createFloatValue(divide(fvpa->span(), fvpb->value())); }
 
 inline
 ValuePtr plus(const NumberNodePtr& fvpa, const FloatValuePtr& fvpb) {
-	return createFloatValue(plus(fvpa->value(), fvpb->value())); }
+	return createFloatValue(plus(fvpa->value(), fvpb->span())); }
 inline
 ValuePtr minus(const NumberNodePtr& fvpa, const FloatValuePtr& fvpb) {
-	return createFloatValue(minus(fvpa->value(), fvpb->value())); }
+	return createFloatValue(minus(fvpa->value(), fvpb->span())); }
 inline
 ValuePtr times(const NumberNodePtr& fvpa, const FloatValuePtr& fvpb) {
-	return createFloatValue(times(fvpa->value(), fvpb->value())); }
+	return createFloatValue(times(fvpa->value(), fvpb->span())); }
 inline
 ValuePtr divide(const NumberNodePtr& fvpa, const FloatValuePtr& fvpb) {
-	return createFloatValue(divide(fvpa->value(), fvpb->value())); }
+	return createFloatValue(divide(fvpa->value(), fvpb->span())); }
 
 ValuePtr plus(const ValuePtr&, const ValuePtr&, bool silent=false);
 ValuePtr minus(const ValuePtr&, const ValuePtr&, bool silent=false);
 ValuePtr times(const ValuePtr&, const ValuePtr&, bool silent=false);
 ValuePtr divide(const ValuePtr&, const ValuePtr&, bool silent=false);
 
+// a*b + c, in one pass; nullptr if the shapes are not supported.
+ValuePtr times_plus(const ValuePtr&, const ValuePtr&, const ValuePtr&);
+
 /** @}*/
 }
 
@@ -90,6 +90,9 @@ TruthValuePtr FormulaPredicateLink::apply(AtomSpace* as,
                                           const HandleSeq& cargs,
                                           bool silent)
 {
+	TruthValuePtr tv(apply_kernels(as, cargs));
+	if (tv) return tv;
+
 	// Collect up two or three floating point values.
 	std::vector<double> nums;
 	for (const Handle& h: getOutgoingSet())
@@ -158,6 +161,60 @@ TruthValuePtr FormulaPredicateLink::apply(AtomSpace* as,
 
 // ---------------------------------------------------------------
 
+/// The same as apply(), but with the compiled formulas: the arguments
+/// are plugged straight into the kernels, instead of being substituted
+/// into a copy of each formula, which is then walked. Returns nullptr
+/// if any one of the formulas is not (yet) compiled, or cannot take
+/// these arguments; apply() then does it the long way.
+TruthValuePtr FormulaPredicateLink::apply_kernels(AtomSpace* as,
+                                                  const HandleSeq& cargs)
+{
+	double nums[3];
+	size_t nnums = 0;
+	for (size_t i = 0; i < _outgoing.size(); i++)
+	{
+		const Handle& h = _outgoing[i];
+		if (h->is_type(VARIABLE_NODE)) continue;
+		if (h->is_type(VARIABLE_LIST)) continue;
+
+		if (NUMBER_NODE == h->get_type())
+		{
+			nums[nnums++] = NumberNodeCast(h)->get_value();
+			continue;
+		}
+
+		const FormulaKernel* fk = _kernels[i].get();
+		if (LAMBDA_LINK == h->get_type())
+		{
+			LambdaLinkPtr lam(LambdaLinkCast(h));
+			const Variables& vars = lam->get_variables();
+			if (not vars.is_type(cargs)) return nullptr;
+			if (nullptr == fk)
+				fk = _kernels[i].miss(lam->get_body(), vars.varseq);
+		}
+		else if (nameserver().isA(h->get_type(), FUNCTION_LINK))
+		{
+			FunctionLinkPtr flp(FunctionLinkCast(h));
+			if (nullptr == flp) return nullptr;
+			const FreeVariables& fvars = flp->get_vars();
+			if (not fvars.empty() and fvars.size() != cargs.size())
+				return nullptr;
+			if (nullptr == fk)
+				fk = _kernels[i].miss(h, fvars.varseq);
+		}
+		else return nullptr;
+
+		if (nullptr == fk) return nullptr;
+		if (not fk->run(as, cargs, nums[nnums++])) return nullptr;
+	}
+
+	if (nnums == 2)
+		return createSimpleTruthValue(nums[0], nums[1]);
+	return createCountTruthValue(std::vector<double>(nums, nums + nnums));
+}
+
+// ---------------------------------------------------------------
+
 /// A shortened, argument-free version of apply()
 TruthValuePtr FormulaPredicateLink::evaluate(AtomSpace* as, bool silent)
 {
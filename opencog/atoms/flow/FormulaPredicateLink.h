@@ -24,6 +24,7 @@
 #define _OPENCOG_FORMULA_PREDICATE_LINK_H
 
 #include <opencog/atoms/core/ScopeLink.h>
+#include <opencog/atoms/reduct/FormulaKernel.h>
 
 namespace opencog
 {
@@ -39,6 +40,10 @@ class FormulaPredicateLink : public ScopeLink
 protected:
 	void init();
 
+	// One compiled formula for each of the two or three outgoing atoms.
+	KernelCache _kernels[3];
+	TruthValuePtr apply_kernels(AtomSpace*, const HandleSeq&);
+
 public:
 	FormulaPredicateLink(const HandleSeq&&, Type=FORMULA_PREDICATE_LINK);
 
@@ -21,11 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
 #include <thread>
 
-#include <opencog/util/platform.h>
-#include <opencog/util/concurrent_queue.h>
+#include <opencog/util/Logger.h>
 
+#include <opencog/atoms/base/WorkerPool.h>
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/execution/Instantiator.h>
 #include <opencog/atoms/parallel/ExecuteThreadedLink.h>
@@ -50,14 +51,24 @@ using namespace opencog;
 /// atoms have been executed, the QueueValue holding the results is
 /// returned. Execution blocks until all of the threads have finished.
 ///
-/// By default, the number of threads launched equals the number of
-/// Atoms in the set. If the NumberNode is present, then the number of
-/// threads is the smaller of the NumberNode and the seize of the Set.
+/// By default, the number of threads used is the number of cores, or
+/// the number of Atoms in the set, whichever is smaller. If the
+/// NumberNode is present, then the number of threads is the smaller
+/// of the NumberNode and the size of the Set.
 ///
-/// XXX TODO: We could have a non-blocking version of this atom. We
-/// could just return the QueueValue immediately; the user could check
-/// to see if the queue is closed, to find out if the threads have
-/// finished.
+/// The threads come from the shared WorkerPool, and are not created
+/// anew for each execution. The calling thread does its share of the
+/// work, too. If this is executed inside of some other parallel run
+/// (say, by a parallel pattern search), then the work is all done
+/// right there, in sequence. The branches of a ParallelLink are not
+/// such runs; an ExecuteThreadedLink in one of them is parallel.
+///
+/// ExecuteAsyncLink is the non-blocking version. It returns the
+/// QueueValue right away; the results are added to it as they come
+/// in, and it is closed when the last of them is in. Readers of the
+/// QueueValue, e.g. LinkValue::value(), wait until then. Exceptions
+/// cannot be passed back to anyone; they are logged, and that Atom
+/// contributes no result.
 
 ExecuteThreadedLink::ExecuteThreadedLink(const HandleSeq&& oset, Type t)
     : Link(std::move(oset), t), _nthreads(-1), _setoff(0)
@@ -79,6 +90,8 @@ ExecuteThreadedLink::ExecuteThreadedLink(const HandleSeq&& oset, Type t)
 		_setoff = 1;
 		st = _outgoing[1]->get_type();
 	}
+	else
+		_nthreads = std::max(1U, std::thread::hardware_concurrency());
 
 	if (SET_LINK != st)
 		throw InvalidParamException(TRACE_INFO,
@@ -87,65 +100,98 @@ ExecuteThreadedLink::ExecuteThreadedLink(const HandleSeq&& oset, Type t)
 	_nthreads = std::min(_nthreads, _outgoing[_setoff]->get_arity());
 }
 
-static void thread_exec(AtomSpace* as, bool silent,
-                        concurrent_queue<Handle>* todo,
-                        QueueValuePtr qvp,
-                        std::exception_ptr* returned_ex)
+// This is "identical" to what cog-execute! would do...
+static void exec_one(AtomSpace* as, const Handle& h, QueueValuePtr& qvp)
 {
-	set_thread_name("atoms:execlink");
-	while (true)
-	{
-		Handle h;
-		if (not todo->try_get(h)) return;
-
-		// This is "identical" to what cog-execute! would do...
-		Instantiator inst(as);
-		try
-		{
-			ValuePtr pap(inst.execute(h));
-			if (pap and pap->is_atom())
-				pap = as->add_atom(HandleCast(pap));
-			qvp->add(std::move(pap));
-		}
-		catch (const std::exception& ex)
-		{
-			*returned_ex = std::current_exception();
-			return;
-		}
-	}
+	Instantiator inst(as);
+	ValuePtr pap(inst.execute(h));
+	if (pap and pap->is_atom())
+		pap = as->add_atom(HandleCast(pap));
+	qvp->add(std::move(pap));
 }
 
 ValuePtr ExecuteThreadedLink::execute(AtomSpace* as,
                                       bool silent)
 {
-	// Place the work items onto a queue.
-	concurrent_queue<Handle> todo_list;
+	if (EXECUTE_ASYNC_LINK == get_type())
+		return execute_async(as);
+
 	const HandleSeq& exes = _outgoing[_setoff]->getOutgoingSet();
-	for (const Handle& h: exes)
-		todo_list.push(h);
+	size_t nexes = exes.size();
 
 	// Where the results will be reported.
 	QueueValuePtr qvp(createQueueValue());
 
-	// Create a collection of joinable threads.
-	std::vector<std::thread> thread_set;
-	std::exception_ptr ex;
-
-	// Launch the workers
-	for (size_t i=0; i<_nthreads; i++)
+	// Each thread takes the next Atom to do, until none are left.
+	// A thread that throws stops there; the pool rethrows to us, once
+	// the others are done.
+	std::atomic<size_t> next(0);
+	workerpool().run(_nthreads, [&](size_t)
 	{
-		thread_set.push_back(std::thread(&thread_exec,
-			as, silent, &todo_list, qvp, &ex));
-	}
-
-	// Wait for it all to come together.
-	for (std::thread& t : thread_set) t.join();
-
-	// Were there any exceptions? If so, rethrow.
-	if (ex) std::rethrow_exception(ex);
+		for (size_t i = next++; i < nexes; i = next++)
+			exec_one(as, exes[i], qvp);
+	});
 
 	qvp->close();
 	return qvp;
 }
 
+// Everything the posted tasks share. It lives until the last of them
+// is done, however long the caller holds on to the QueueValue; and so
+// does the AtomSpace.
+struct AsyncExec
+{
+	AtomSpacePtr as;
+	HandleSeq exes;
+	QueueValuePtr qvp;
+	std::atomic<size_t> next;
+	std::atomic<size_t> running;
+};
+
+// The last task out closes the queue, however it leaves; otherwise,
+// the readers would wait for it forever.
+struct LastOut
+{
+	AsyncExec& ax;
+	~LastOut() { if (0 == --ax.running) ax.qvp->close(); }
+};
+
+ValuePtr ExecuteThreadedLink::execute_async(AtomSpace* as)
+{
+	std::shared_ptr<AsyncExec> ax(std::make_shared<AsyncExec>());
+	ax->as = AtomSpaceCast(as);
+	ax->exes = _outgoing[_setoff]->getOutgoingSet();
+	ax->qvp = createQueueValue();
+	ax->next = 0;
+	ax->running = _nthreads;
+
+	// With nothing to do, no one would ever close it.
+	if (0 == _nthreads)
+	{
+		ax->qvp->close();
+		return ax->qvp;
+	}
+
+	for (size_t t = 0; t < _nthreads; t++)
+		workerpool().post([ax]()
+		{
+			LastOut last{*ax};
+			size_t nexes = ax->exes.size();
+			for (size_t i = ax->next++; i < nexes; i = ax->next++)
+			{
+				try { exec_one(ax->as.get(), ax->exes[i], ax->qvp); }
+				catch (const std::exception& ex)
+				{
+					logger().warn("ExecuteAsyncLink: %s", ex.what());
+				}
+				catch (...)
+				{
+					logger().warn("ExecuteAsyncLink: unknown exception");
+				}
+			}
+		});
+
+	return ax->qvp;
+}
+
 DEFINE_LINK_FACTORY(ExecuteThreadedLink, EXECUTE_THREADED_LINK)
@@ -40,6 +40,8 @@ protected:
 	size_t _nthreads;
 	size_t _setoff;
 
+	ValuePtr execute_async(AtomSpace*);
+
 public:
 	ExecuteThreadedLink(const HandleSeq&&, Type=EXECUTE_THREADED_LINK);
 	ExecuteThreadedLink(const ExecuteThreadedLink&) = delete;
@@ -21,9 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <thread>
-
 #include <opencog/util/platform.h>
+#include <opencog/atoms/base/WorkerPool.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
 #include <opencog/atoms/parallel/ParallelLink.h>
 
@@ -55,12 +54,10 @@ void ParallelLink::evaluate_scratch(AtomSpace* as,
                                     bool silent,
                                     AtomSpace* scratch)
 {
-	// Create and detach threads; return immediately.
+	// Hand each branch to the pool; return immediately. Each one
+	// gets a thread of its own, without waiting for the others.
 	for (const Handle& h : _outgoing)
-	{
-		std::thread thr(&thread_eval, as, h, scratch, silent);
-		thr.detach();
-	}
+		workerpool().post([=]() { thread_eval(as, h, scratch, silent); });
 }
 
 bool ParallelLink::bevaluate(AtomSpace* as, bool silent)
@@ -21,9 +21,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <thread>
+#include <condition_variable>
+#include <mutex>
 
 #include <opencog/util/platform.h>
+#include <opencog/atoms/base/WorkerPool.h>
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
 #include <opencog/atoms/parallel/ThreadJoinLink.h>
@@ -61,17 +63,27 @@ bool ThreadJoinLink::evaluate_scratch(AtomSpace* as,
 	size_t arity = _outgoing.size();
 	std::vector<TruthValuePtr> tvp(arity);
 
-	// Create a collection of joinable threads.
-	std::vector<std::thread> thread_set;
+	// Each branch runs on a pool thread of its own, so that they all
+	// run at once, as they would on threads of their own.
+	std::mutex mtx;
+	std::condition_variable cv;
+	size_t pending = arity;
 	std::exception_ptr ex;
 	for (size_t i=0; i<arity; i++)
 	{
-		thread_set.push_back(std::thread(&thread_eval_tv,
-			as, _outgoing[i], scratch, silent, &tvp[i], &ex));
+		workerpool().post([&, i]()
+		{
+			thread_eval_tv(as, _outgoing[i], scratch, silent, &tvp[i], &ex);
+			std::lock_guard<std::mutex> lck(mtx);
+			if (0 == --pending) cv.notify_one();
+		});
 	}
 
 	// Wait for it all to come together.
-	for (std::thread& t : thread_set) t.join();
+	{
+		std::unique_lock<std::mutex> lck(mtx);
+		cv.wait(lck, [&]() { return 0 == pending; });
+	}
 
 	// Were there any exceptions? If so, rethrow.
 	if (ex) std::rethrow_exception(ex);
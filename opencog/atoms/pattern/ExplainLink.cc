@@ -0,0 +1,84 @@
+/*
+ * opencog/atoms/pattern/ExplainLink.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/query/Implicator.h>
+#include <opencog/query/Satisfier.h>
+
+#include "ExplainLink.h"
+#include "PatternLink.h"
+
+using namespace opencog;
+
+void ExplainLink::init(void)
+{
+	if (1 != _outgoing.size())
+		throw InvalidParamException(TRACE_INFO,
+			"ExplainLink expects one QueryLink or MeetLink, got %lu atoms",
+			_outgoing.size());
+
+	Type t = _outgoing[0]->get_type();
+	if (not nameserver().isA(t, QUERY_LINK) and
+	    not nameserver().isA(t, MEET_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"ExplainLink expects a QueryLink or MeetLink, got %s",
+			tname.c_str());
+	}
+}
+
+ExplainLink::ExplainLink(const HandleSeq&& hseq, Type t)
+	: Link(std::move(hseq), t)
+{
+	init();
+}
+
+/* ================================================================= */
+
+ValuePtr ExplainLink::execute(AtomSpace* as, bool silent)
+{
+	if (nullptr == as) as = _atom_space;
+
+	const Handle& query(_outgoing[0]);
+	PatternLinkPtr plp(PatternLinkCast(query));
+	ContainerValuePtr cvp(createQueueValue());
+
+	if (query->is_type(QUERY_LINK))
+	{
+		Implicator impl(as, cvp);
+		impl.set_explain(true);
+		impl.satisfy(plp);
+		return createStringValue(impl.explain());
+	}
+
+	SatisfyingSet sater(as, cvp);
+	sater.set_explain(true);
+	sater.satisfy(plp);
+	return createStringValue(sater.explain());
+}
+
+DEFINE_LINK_FACTORY(ExplainLink, EXPLAIN_LINK)
+
+/* ===================== END OF FILE ===================== */
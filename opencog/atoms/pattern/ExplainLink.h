@@ -0,0 +1,65 @@
+/*
+ * opencog/atoms/pattern/ExplainLink.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_EXPLAIN_LINK_H
+#define _OPENCOG_EXPLAIN_LINK_H
+
+#include <opencog/atoms/base/Link.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// The ExplainLink runs the QueryLink or MeetLink that it holds, and
+/// returns, in a StringValue, the plans that the search followed, with
+/// the estimated and the actual number of groundings at each step:
+///
+///    (ExplainLink (QueryLink ...))
+///
+/// The groundings themselves are thrown away. Searches that were not
+/// planned (too few clauses, or choices or globs in the pattern) say
+/// so, instead.
+class ExplainLink : public Link
+{
+protected:
+	void init(void);
+
+public:
+	ExplainLink(const HandleSeq&&, Type=EXPLAIN_LINK);
+
+	ExplainLink(const ExplainLink&) = delete;
+	ExplainLink operator=(const ExplainLink&) = delete;
+
+	virtual bool is_executable() const { return true; }
+	virtual ValuePtr execute(AtomSpace*, bool silent=false);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(ExplainLink)
+#define createExplainLink CREATE_DECL(ExplainLink)
+
+/** @}*/
+}
+
+#endif // _OPENCOG_EXPLAIN_LINK_H
@@ -10,7 +10,9 @@
 #include <opencog/atoms/base/ClassServer.h>
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/Float32Value.h>
 #include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/UInt32Value.h>
 #include "AccumulateLink.h"
 
 using namespace opencog;
@@ -58,10 +60,30 @@ ValuePtr AccumulateLink::execute(AtomSpace* as, bool silent)
 		return createNumberNode(acc);
 	}
 
+	// Compact vectors give a compact sum. The floats are summed in
+	// double precision, the counts in 64 bits.
+	if (FLOAT32_VALUE == vitype)
+	{
+		double acc = 0.0;
+		for (float f : Float32ValueCast(vi)->value32())
+			acc += f;
+		return createFloat32Value((float) acc);
+	}
+
+	if (UINT32_VALUE == vitype)
+	{
+		uint64_t acc = 0;
+		for (uint32_t u : UInt32ValueCast(vi)->value32())
+			acc += u;
+		if (acc <= UINT32_MAX)
+			return createUInt32Value((uint32_t) acc);
+		return createFloatValue((double) acc);
+	}
+
 	// If its a float value, it's a vector. Sum.
 	if (nameserver().isA(vitype, FLOAT_VALUE))
 	{
-		const std::vector<double>& dvec(FloatValueCast(vi)->value());
+		FloatSpan dvec(FloatValueCast(vi)->span());
 		double acc = 0.0;
 		for (double dv : dvec)
 			acc += dv;
@@ -158,8 +158,28 @@ Handle ArithmeticLink::reorder(void) const
 // ===========================================================
 
 /// execute() -- Execute the expression
+///
+/// Expressions that are executed more than once are compiled, if they
+/// can be; see FormulaKernel.h. Expressions over vectors are fused;
+/// see VectorKernel.h.
 ValuePtr ArithmeticLink::execute(AtomSpace* as, bool silent)
 {
+	const FormulaKernel* fk = _kernel.get();
+	if (nullptr == fk) fk = _kernel.miss(get_handle(), HandleSeq());
+	if (fk)
+	{
+		ValuePtr vp(fk->execute(as, HandleSeq()));
+		if (vp) return vp;
+	}
+
+	// Trees of vector arithmetic are run in a single pass.
+	const VectorKernel* vk = _vector.get(get_handle());
+	if (vk)
+	{
+		ValuePtr vp(vk->execute(as, silent));
+		if (vp) return vp;
+	}
+
 	return delta_reduce(as, silent);
 }
 
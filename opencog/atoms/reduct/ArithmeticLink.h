@@ -24,6 +24,8 @@
 #define _OPENCOG_ARITHMETIC_LINK_H
 
 #include <opencog/atoms/reduct/FoldLink.h>
+#include <opencog/atoms/reduct/FormulaKernel.h>
+#include <opencog/atoms/reduct/VectorKernel.h>
 
 namespace opencog
 {
@@ -43,6 +45,13 @@ protected:
 	virtual Handle reorder(void) const;
 	bool _commutative;
 
+	// The compiled form, for closed expressions that get executed
+	// over and over, e.g. by a FormulaTruthValue.
+	KernelCache _kernel;
+
+	// The fused form, for trees of vector arithmetic.
+	VectorKernelCache _vector;
+
 
 public:
 	ArithmeticLink(const HandleSeq&&, Type);
@@ -11,9 +11,11 @@
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/reduct/NumericFunctionLink.h>
 #include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/Float32Value.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/UInt32Value.h>
 #include "DecimateLink.h"
 
 using namespace opencog;
@@ -88,6 +90,22 @@ ValuePtr DecimateLink::execute(AtomSpace* as, bool silent)
 		return do_execute(vmask, vi);
 	}
 
+	if (FLOAT32_VALUE == mtype)
+	{
+		std::vector<bool> vmask;
+		for (float f : Float32ValueCast(vm)->value32())
+			vmask.emplace_back(0 < f);
+		return do_execute(vmask, vi);
+	}
+
+	if (UINT32_VALUE == mtype)
+	{
+		std::vector<bool> vmask;
+		for (uint32_t u : UInt32ValueCast(vm)->value32())
+			vmask.emplace_back(0 < u);
+		return do_execute(vmask, vi);
+	}
+
 	throw SyntaxException(TRACE_INFO, "Mask must be a BoolValue!");
 }
 
@@ -100,6 +118,25 @@ ValuePtr DecimateLink::do_execute(const std::vector<bool>& vmask,
 	size_t len = std::min(vmask.size(), vi->size());
 
 	// Handle the various value types. Try the most likely ones first.
+	// Compact vectors stay compact.
+	if (FLOAT32_VALUE == vitype)
+	{
+		const std::vector<float>& fvec(Float32ValueCast(vi)->value32());
+		std::vector<float> chopped;
+		for (size_t i=0; i<len; i++)
+			if (vmask[i]) chopped.push_back(fvec[i]);
+		return createFloat32Value(std::move(chopped));
+	}
+
+	if (UINT32_VALUE == vitype)
+	{
+		const std::vector<uint32_t>& uvec(UInt32ValueCast(vi)->value32());
+		std::vector<uint32_t> chopped;
+		for (size_t i=0; i<len; i++)
+			if (vmask[i]) chopped.push_back(uvec[i]);
+		return createUInt32Value(std::move(chopped));
+	}
+
 	// If its a float value, it's a vector.
 	if (nameserver().isA(vitype, FLOAT_VALUE))
 	{
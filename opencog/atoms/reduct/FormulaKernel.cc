@@ -0,0 +1,364 @@
+/*
+ * opencog/atoms/reduct/FormulaKernel.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cfloat>
+#include <cmath>
+
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include "FormulaKernel.h"
+
+using namespace opencog;
+
+bool FormulaKernel::enabled = true;
+
+FormulaKernel::FormulaKernel(void) :
+	_nvars(0), _nregs(0), _number(true)
+{
+}
+
+FormulaKernel::~FormulaKernel()
+{
+}
+
+// ===========================================================
+
+void FormulaKernel::push(Op op, size_t dst, size_t a, size_t b, size_t idx)
+{
+	_code.push_back({op, (uint8_t) dst, (uint8_t) a, (uint8_t) b,
+	                 (uint32_t) idx});
+	_nregs = std::max(_nregs, std::max(dst, std::max(a, b)) + 1);
+}
+
+static bool is_single_number(const Handle& h)
+{
+	return NUMBER_NODE == h->get_type() and
+		1 == NumberNodeCast(h)->size();
+}
+
+static int var_index(const Handle& h, const HandleSeq& vars)
+{
+	for (size_t i = 0; i < vars.size(); i++)
+		if (h == vars[i]) return i;
+	return -1;
+}
+
+/// The StrengthOf, ConfidenceOf or CountOf a single atom. The TV of
+/// a constant atom is looked up when the kernel runs, not now: it
+/// may change between runs.
+bool FormulaKernel::emit_tv(const Handle& h, const HandleSeq& vars,
+                            Op op, size_t reg)
+{
+	if (1 != h->get_arity()) return false;
+	const Handle& atom = h->getOutgoingAtom(0);
+
+	int vi = var_index(atom, vars);
+	if (0 <= vi)
+	{
+		push(op, reg, 1, 0, vi);
+		return true;
+	}
+
+	// As in TruthValueOfLink: the TV of an unbound variable cannot
+	// be had, and that of an evaluatable atom must be computed.
+	Type t = atom->get_type();
+	if (VARIABLE_NODE == t or GLOB_NODE == t) return false;
+	if (atom->is_evaluatable() or nameserver().isA(t, EVALUATABLE_LINK))
+		return false;
+
+	push(op, reg, 0, 0, _atoms.size());
+	_atoms.push_back(atom);
+	return true;
+}
+
+/// A right fold, as in FoldLink::delta_reduce(): the last operand
+/// first, then each operand, right to left, combined with the result
+/// so far.
+bool FormulaKernel::emit_fold(const HandleSeq& oset, const HandleSeq& vars,
+                              Op op, size_t reg, bool& num)
+{
+	if (0 == oset.size()) return false;
+
+	if (not emit(oset.back(), vars, reg, num)) return false;
+	for (size_t i = oset.size() - 1; 0 < i; i--)
+	{
+		bool n;
+		if (not emit(oset[i-1], vars, reg+1, n)) return false;
+		push(op, reg, reg+1, reg);
+		num = num and n;
+	}
+	return true;
+}
+
+/// Compile `h` so that its value ends up in register `reg`; the
+/// registers above `reg` are scratch. `num` is set if the tree walk
+/// would give a NumberNode, and not a FloatValue.
+bool FormulaKernel::emit(const Handle& h, const HandleSeq& vars,
+                         size_t reg, bool& num)
+{
+	// Leave room for the scratch register of a fold.
+	if (MAX_REGS <= reg + 1) return false;
+
+	Type t = h->get_type();
+	if (NUMBER_NODE == t)
+	{
+		if (not is_single_number(h)) return false;
+		push(CONST, reg, 0, 0, _consts.size());
+		_consts.push_back(NumberNodeCast(h)->get_value());
+		num = true;
+		return true;
+	}
+
+	// The arguments are checked to be NumberNodes, when run.
+	if (VARIABLE_NODE == t)
+	{
+		int vi = var_index(h, vars);
+		if (vi < 0) return false;
+		push(ARG, reg, 0, 0, vi);
+		num = true;
+		return true;
+	}
+
+	if (not h->is_link()) return false;
+	const HandleSeq& oset = h->getOutgoingSet();
+
+	num = false;
+	if (STRENGTH_OF_LINK == t) return emit_tv(h, vars, STRENGTH, reg);
+	if (CONFIDENCE_OF_LINK == t) return emit_tv(h, vars, CONFIDENCE, reg);
+	if (COUNT_OF_LINK == t) return emit_tv(h, vars, COUNT, reg);
+
+	// ArithmeticLink::reorder() puts the variables first, then the
+	// expressions, then the numbers. But the tree walk reorders only
+	// after the arguments have been substituted, and so the variables
+	// end up with the numbers.
+	if (PLUS_LINK == t or TIMES_LINK == t)
+	{
+		HandleSeq ordered;
+		for (const Handle& ho : oset)
+		{
+			Type ot = ho->get_type();
+			if (SET_LINK == ot) return false;
+			if (NUMBER_NODE != ot and VARIABLE_NODE != ot)
+				ordered.push_back(ho);
+		}
+		for (const Handle& ho : oset)
+		{
+			Type ot = ho->get_type();
+			if (NUMBER_NODE == ot or VARIABLE_NODE == ot)
+				ordered.push_back(ho);
+		}
+		return emit_fold(ordered, vars, PLUS_LINK == t ? ADD : MUL,
+		                 reg, num);
+	}
+
+	// The unary forms already have the 0 or 1 inserted.
+	if (MINUS_LINK == t) return emit_fold(oset, vars, SUB, reg, num);
+	if (DIVIDE_LINK == t) return emit_fold(oset, vars, DIV, reg, num);
+
+	// MinLink and MaxLink start from the largest (smallest) double,
+	// and give a NumberNode if any one of the arguments was one.
+	if (MIN_LINK == t or MAX_LINK == t)
+	{
+		if (0 == oset.size()) return false;
+		push(CONST, reg, 0, 0, _consts.size());
+		_consts.push_back(MIN_LINK == t ? DBL_MAX : -DBL_MAX);
+		for (const Handle& ho : oset)
+		{
+			bool n;
+			if (not emit(ho, vars, reg+1, n)) return false;
+			push(MIN_LINK == t ? MIN : MAX, reg, reg, reg+1);
+			num = num or n;
+		}
+		return true;
+	}
+
+	if (POW_LINK == t)
+	{
+		if (2 != oset.size()) return false;
+		bool n;
+		if (not emit(oset[0], vars, reg, num)) return false;
+		if (not emit(oset[1], vars, reg+1, n)) return false;
+		push(POW, reg, reg, reg+1);
+		num = num and n;
+		return true;
+	}
+
+	Op op;
+	if (FLOOR_LINK == t) op = FLOOR;
+	else if (HEAVISIDE_LINK == t) op = HEAVISIDE;
+	else if (LOG2_LINK == t) op = LOG2;
+	else if (SINE_LINK == t) op = SIN;
+	else if (COSINE_LINK == t) op = COS;
+	else if (TAN_LINK == t) op = TAN;
+	else if (EXP_LINK == t) op = EXP;
+	else return false;
+
+	if (1 != oset.size()) return false;
+	if (not emit(oset[0], vars, reg, num)) return false;
+	push(op, reg, reg, 0);
+	return true;
+}
+
+FormulaKernel* FormulaKernel::compile(const Handle& body,
+                                      const HandleSeq& vars)
+{
+	FormulaKernel* fk = new FormulaKernel();
+	fk->_nvars = vars.size();
+	if (not fk->emit(body, vars, 0, fk->_number))
+	{
+		delete fk;
+		return nullptr;
+	}
+	return fk;
+}
+
+// ===========================================================
+
+/// The same lookup as get_the_tv() in TruthValueOfLink.cc, for atoms
+/// that are not evaluatable.
+static void tv_of(AtomSpace* as, const Handle& h, FormulaKernel::Op op,
+                  double& x)
+{
+	TruthValuePtr tv;
+	if (as and as != h->getAtomSpace())
+		tv = as->add_atom(h)->getTruthValue();
+	else
+		tv = h->getTruthValue();
+
+	if (FormulaKernel::STRENGTH == op) x = tv->get_mean();
+	else if (FormulaKernel::CONFIDENCE == op) x = tv->get_confidence();
+	else x = tv->get_count();
+}
+
+bool FormulaKernel::run(AtomSpace* as, const HandleSeq& args,
+                        double& result) const
+{
+	if (args.size() < _nvars) return false;
+
+	double r[MAX_REGS];
+	for (const Insn& in : _code)
+	{
+		switch (in.op)
+		{
+			case CONST:
+				r[in.dst] = _consts[in.idx];
+				break;
+			case ARG:
+			{
+				const Handle& h = args[in.idx];
+				if (NUMBER_NODE != h->get_type()) return false;
+				const NumberNode* nn = static_cast<const NumberNode*>(h.get());
+				if (1 != nn->size()) return false;
+				r[in.dst] = nn->get_value();
+				break;
+			}
+			case STRENGTH:
+			case CONFIDENCE:
+			case COUNT:
+			{
+				if (0 == in.a)
+				{
+					tv_of(as, _atoms[in.idx], in.op, r[in.dst]);
+					break;
+				}
+				const Handle& h = args[in.idx];
+				Type t = h->get_type();
+				if (VARIABLE_NODE == t or GLOB_NODE == t) return false;
+				if (h->is_evaluatable() or
+				    nameserver().isA(t, EVALUATABLE_LINK))
+					return false;
+				tv_of(as, h, in.op, r[in.dst]);
+				break;
+			}
+			case ADD: r[in.dst] = r[in.a] + r[in.b]; break;
+			case SUB: r[in.dst] = r[in.a] - r[in.b]; break;
+			case MUL: r[in.dst] = r[in.a] * r[in.b]; break;
+			case DIV: r[in.dst] = r[in.a] / r[in.b]; break;
+			case MIN: r[in.dst] = std::min(r[in.a], r[in.b]); break;
+			case MAX: r[in.dst] = std::max(r[in.a], r[in.b]); break;
+			case POW: r[in.dst] = pow(r[in.a], r[in.b]); break;
+			case FLOOR: r[in.dst] = floor(r[in.a]); break;
+			case HEAVISIDE: r[in.dst] = 1 - std::signbit(r[in.a]); break;
+			case LOG2: r[in.dst] = log2(r[in.a]); break;
+			case SIN: r[in.dst] = sin(r[in.a]); break;
+			case COS: r[in.dst] = cos(r[in.a]); break;
+			case TAN: r[in.dst] = tan(r[in.a]); break;
+			case EXP: r[in.dst] = exp(r[in.a]); break;
+		}
+	}
+	result = r[0];
+	return true;
+}
+
+ValuePtr FormulaKernel::execute(AtomSpace* as, const HandleSeq& args) const
+{
+	double x;
+	if (not run(as, args, x)) return nullptr;
+
+	// The NumberNode is made from a vector, as the tree walk makes it,
+	// so that the name is printed the same way.
+	if (_number)
+		return createNumberNode(std::vector<double>({x}));
+	return createFloatValue(x);
+}
+
+// ===========================================================
+
+KernelCache::KernelCache(void) :
+	_kernel(nullptr), _misses(0), _failed(false)
+{
+}
+
+KernelCache::~KernelCache()
+{
+	delete _kernel.load();
+}
+
+const FormulaKernel* KernelCache::miss(const Handle& body,
+                                       const HandleSeq& vars)
+{
+	if (not FormulaKernel::enabled) return nullptr;
+	if (_failed.load(std::memory_order_relaxed)) return nullptr;
+	if (0 == _misses.fetch_add(1, std::memory_order_relaxed))
+		return nullptr;
+
+	const FormulaKernel* fk = FormulaKernel::compile(body, vars);
+	if (nullptr == fk)
+	{
+		_failed = true;
+		return nullptr;
+	}
+
+	// Two threads may have compiled it at once; keep the first.
+	const FormulaKernel* expect = nullptr;
+	if (not _kernel.compare_exchange_strong(expect, fk))
+	{
+		delete fk;
+		return expect;
+	}
+	return fk;
+}
+
+/* ===================== END OF FILE ===================== */
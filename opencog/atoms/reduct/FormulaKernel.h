@@ -0,0 +1,174 @@
+/*
+ * opencog/atoms/reduct/FormulaKernel.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FORMULA_KERNEL_H
+#define _OPENCOG_FORMULA_KERNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * A FormulaKernel is an arithmetic expression, such as the strength
+ * and confidence formulas of PLN, flattened into a short list of
+ * register instructions. Running it does what the tree walk in
+ * FoldLink::delta_reduce() and NumericFunctionLink::execute() would
+ * do, for scalar arguments, but without creating any intermediate
+ * NumberNodes or FloatValues, and without substituting the arguments
+ * into a copy of the expression.
+ *
+ * Only closed, scalar expressions are compiled: Plus, Minus, Times,
+ * Divide, Min, Max, Pow and the unary NumericFunctionLinks, over
+ * single-valued NumberNodes, the variables given to compile(), and
+ * the StrengthOf, ConfidenceOf and CountOf a single atom or variable.
+ * Anything else (RandomNumber, DefinedSchemas, GetLinks, vectors of
+ * numbers, unbound variables) is left to the tree walk.
+ *
+ * The operations are carried out in exactly the order the tree walk
+ * would carry them out (a right fold, with the operands of Plus and
+ * Times re-ordered as ArithmeticLink::reorder() does) so that the
+ * results are identical, and not just close.
+ */
+class FormulaKernel
+{
+public:
+	enum Op : uint8_t
+	{
+		CONST,        // r[dst] = _consts[idx]
+		ARG,          // r[dst] = args[idx], which must be a NumberNode
+		STRENGTH,     // r[dst] = TV of _atoms[idx], or of args[idx] if a
+		CONFIDENCE,
+		COUNT,
+		ADD,          // r[dst] = r[a] op r[b]
+		SUB,
+		MUL,
+		DIV,
+		MIN,
+		MAX,
+		POW,
+		FLOOR,        // r[dst] = fn(r[a])
+		HEAVISIDE,
+		LOG2,
+		SIN,
+		COS,
+		TAN,
+		EXP,
+	};
+
+	struct Insn
+	{
+		Op op;
+		uint8_t dst;
+		uint8_t a;
+		uint8_t b;
+		uint32_t idx;
+	};
+
+	/// Expressions nested deeper than this are not compiled.
+	static const size_t MAX_REGS = 32;
+
+	/// Set to false to always walk the tree; for benchmarking.
+	static bool enabled;
+
+private:
+	std::vector<Insn> _code;
+	std::vector<double> _consts;
+	HandleSeq _atoms;
+	size_t _nvars;
+	size_t _nregs;
+	bool _number;
+
+	FormulaKernel(void);
+	bool emit(const Handle&, const HandleSeq&, size_t reg, bool& num);
+	bool emit_fold(const HandleSeq&, const HandleSeq&, Op,
+	               size_t reg, bool& num);
+	bool emit_tv(const Handle&, const HandleSeq&, Op, size_t reg);
+	void push(Op, size_t dst, size_t a, size_t b, size_t idx=0);
+
+public:
+	~FormulaKernel();
+
+	/// Compile `body`, with `vars` standing for the arguments that
+	/// will be passed to run(). Returns nullptr if the expression
+	/// cannot be compiled.
+	static FormulaKernel* compile(const Handle& body, const HandleSeq& vars);
+
+	/// Compute the value of the expression. Returns false if the
+	/// arguments are not what the kernel was compiled for (an
+	/// argument is not a number, or has no truth value to be had);
+	/// the caller must then walk the tree instead.
+	bool run(AtomSpace*, const HandleSeq& args, double& result) const;
+
+	/// The result of run(), as the tree walk would have returned it:
+	/// a NumberNode if only NumberNodes went into it, else a
+	/// FloatValue. Returns nullptr where run() returns false.
+	ValuePtr execute(AtomSpace*, const HandleSeq& args) const;
+
+	/// The number of instructions.
+	size_t size(void) const { return _code.size(); }
+};
+
+/**
+ * The compiled form of one expression, kept with the Atom holding the
+ * expression. Compilation is put off until the second time the
+ * expression is asked for, so that expressions that are built, run
+ * once and thrown away do not pay for it.
+ */
+class KernelCache
+{
+	std::atomic<const FormulaKernel*> _kernel;
+	std::atomic<uint8_t> _misses;
+	std::atomic<bool> _failed;
+
+public:
+	KernelCache(void);
+	KernelCache(const KernelCache&) = delete;
+	KernelCache& operator=(const KernelCache&) = delete;
+	~KernelCache();
+
+	/// The kernel, if it has been compiled.
+	const FormulaKernel* get(void) const
+	{
+		if (not FormulaKernel::enabled) return nullptr;
+		return _kernel.load(std::memory_order_acquire);
+	}
+
+	/// Count a lookup that found no kernel; compile on the second.
+	/// Returns the kernel, or nullptr if there is none (yet).
+	const FormulaKernel* miss(const Handle& body, const HandleSeq& vars);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_FORMULA_KERNEL_H
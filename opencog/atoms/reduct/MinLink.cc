@@ -53,7 +53,7 @@ ValuePtr MinLink::execute(AtomSpace* as, bool silent)
 		}
 		else if (nameserver().isA(vitype, FLOAT_VALUE))
 		{
-			const std::vector<double>& dvec(FloatValueCast(vi)->value());
+			FloatSpan dvec(FloatValueCast(vi)->span());
 			len = std::min(len, dvec.size());
 			result.resize(len, DBL_MAX);
 			for (size_t i = 0; i<len; i++)
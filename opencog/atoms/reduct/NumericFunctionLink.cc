@@ -72,24 +72,25 @@ void NumericFunctionLink::init(void)
 // ===========================================================
 
 /// Generic utility -- convert the argument to a vector of doubles,
-/// if possible.  Return nullptr if not possible.
-const std::vector<double>*
+/// if possible.  Return false if not possible. The numbers are not
+/// copied; `vptr` must be kept alive for as long as `vec` is used.
+bool
 NumericFunctionLink::get_vector(AtomSpace* as, bool silent,
-                                ValuePtr vptr, Type& t)
+                                ValuePtr vptr, Type& t, FloatSpan& vec)
 {
 	t = vptr->get_type();
 
 	bool is_fv = nameserver().isA(t, FLOAT_VALUE);
 	bool is_nu = (NUMBER_NODE == t);
 
-	if (not is_fv and not is_nu) return nullptr;
+	if (not is_fv and not is_nu) return false;
 
 	if (is_nu)
-		return & NumberNodeCast(vptr)->value();
+		vec = NumberNodeCast(vptr)->value();
 	if (is_fv)
-		return & FloatValueCast(vptr)->value();
+		vec = FloatValueCast(vptr)->span();
 
-	return nullptr; // not reached
+	return true;
 }
 
 // ============================================================
@@ -110,16 +111,17 @@ NumericFunctionLink::apply_func(AtomSpace* as, bool silent,
 
 	// get_vector gets numeric values, if possible.
 	Type vxtype;
-	const std::vector<double>* xvec = get_vector(as, silent, vx, vxtype);
+	FloatSpan xvec;
+	bool have_x = get_vector(as, silent, vx, vxtype, xvec);
 
 	// No numeric values available. Sorry!
-	if (nullptr == xvec or 0 == xvec->size())
+	if (not have_x or 0 == xvec.size())
 		return nullptr;
 
 	std::vector<double> funvec;
-	size_t sz = xvec->size();
+	size_t sz = xvec.size();
 	for (size_t i=0; i<sz; i++)
-		funvec.push_back(fun(xvec->operator[](i)));
+		funvec.push_back(fun(xvec[i]));
 
 	if (NUMBER_NODE == vxtype)
 		return createNumberNode(funvec);
@@ -146,14 +148,16 @@ NumericFunctionLink::apply_func(AtomSpace* as, bool silent,
 
 	// get_vector gets numeric values, if possible.
 	Type vxtype;
-	const std::vector<double>* xvec = get_vector(as, silent, vx, vxtype);
+	FloatSpan xvec;
+	bool have_x = get_vector(as, silent, vx, vxtype, xvec);
 
 	Type vytype;
-	const std::vector<double>* yvec = get_vector(as, silent, vy, vytype);
+	FloatSpan yvec;
+	bool have_y = get_vector(as, silent, vy, vytype, yvec);
 
 	// No numeric values available. Sorry!
-	if (nullptr == xvec or nullptr == yvec or
-	    0 == xvec->size() or 0 == yvec->size())
+	if (not have_x or not have_y or
+	    0 == xvec.size() or 0 == yvec.size())
 	{
 		reduction.push_back(vx);
 		reduction.push_back(vy);
@@ -161,23 +165,23 @@ NumericFunctionLink::apply_func(AtomSpace* as, bool silent,
 	}
 
 	std::vector<double> funvec;
-	if (1 == xvec->size())
+	if (1 == xvec.size())
 	{
-		double x = xvec->back();
-		for (double y : *yvec)
+		double x = xvec.back();
+		for (double y : yvec)
 			funvec.push_back(fun(x, y));
 	}
-	else if (1 == yvec->size())
+	else if (1 == yvec.size())
 	{
-		double y = yvec->back();
-		for (double x : *xvec)
+		double y = yvec.back();
+		for (double x : xvec)
 			funvec.push_back(fun(x, y));
 	}
 	else
 	{
-		size_t sz = std::min(xvec->size(), yvec->size());
+		size_t sz = std::min(xvec.size(), yvec.size());
 		for (size_t i=0; i<sz; i++)
-			funvec.push_back(fun(xvec->operator[](i), yvec->operator[](i)));
+			funvec.push_back(fun(xvec[i], yvec[i]));
 	}
 
 	if (NUMBER_NODE == vxtype and NUMBER_NODE == vytype)
@@ -304,6 +308,23 @@ ValuePtr NumericFunctionLink::execute_binary(AtomSpace *as, bool silent)
 
 ValuePtr NumericFunctionLink::execute(AtomSpace* as, bool silent)
 {
+	// Compiled on the second execution; see FormulaKernel.h
+	const FormulaKernel* fk = _kernel.get();
+	if (nullptr == fk) fk = _kernel.miss(get_handle(), HandleSeq());
+	if (fk)
+	{
+		ValuePtr vp(fk->execute(as, HandleSeq()));
+		if (vp) return vp;
+	}
+
+	// Trees of vector arithmetic are run in a single pass.
+	const VectorKernel* vk = _vector.get(get_handle());
+	if (vk)
+	{
+		ValuePtr vp(vk->execute(as, silent));
+		if (vp) return vp;
+	}
+
 	if (1 == _outgoing.size())
 		return execute_unary(as, silent);
 	return execute_binary(as, silent);
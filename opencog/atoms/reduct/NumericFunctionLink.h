@@ -24,6 +24,9 @@
 #define _OPENCOG_NUMERIC_FUNCTION_LINK_H
 
 #include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/atoms/reduct/FormulaKernel.h>
+#include <opencog/atoms/reduct/VectorKernel.h>
+#include <opencog/atoms/value/FloatValue.h>
 
 namespace opencog
 {
@@ -39,11 +42,12 @@ class NumericFunctionLink : public FunctionLink
 {
 protected:
 	void init();
+	KernelCache _kernel;
+	VectorKernelCache _vector;
 	ValuePtr execute_unary(AtomSpace*, bool);
 	ValuePtr execute_binary(AtomSpace*, bool);
 
-	static const std::vector<double>* get_vector(AtomSpace*, bool,
-		ValuePtr, Type&);
+	static bool get_vector(AtomSpace*, bool, ValuePtr, Type&, FloatSpan&);
 	static ValuePtr apply_func(AtomSpace*, bool, const Handle&,
 		double (*)(double), ValuePtr&);
 	static ValuePtr apply_func(AtomSpace*, bool, const HandleSeq&,
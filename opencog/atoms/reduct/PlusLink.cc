@@ -44,12 +44,44 @@ void PlusLink::init(void)
 
 // ============================================================
 
+/// Operands that can be looked at twice: fetching them has no side
+/// effects, and costs little.
+static bool is_plain(const Handle& h)
+{
+	Type t = h->get_type();
+	return NUMBER_NODE == t or VALUE_OF_LINK == t or
+		FLOAT_VALUE_OF_LINK == t;
+}
+
+/// (Plus (Times a b) c) over vectors: compute a*b + c in one pass,
+/// instead of making the vector a*b and then adding c to it.
+/// Returns nullptr if the operands are not numeric vectors of the
+/// right shape; the caller then proceeds as usual.
+static ValuePtr fuse_times(AtomSpace* as, bool silent,
+                           const Handle& times, const ValuePtr& vc)
+{
+	if (2 != times->get_arity()) return nullptr;
+	const Handle& ha = times->getOutgoingAtom(0);
+	const Handle& hb = times->getOutgoingAtom(1);
+	if (not is_plain(ha) or not is_plain(hb)) return nullptr;
+
+	ValuePtr va(NumericFunctionLink::get_value(as, silent, ha));
+	ValuePtr vb(NumericFunctionLink::get_value(as, silent, hb));
+	return times_plus(va, vb, vc);
+}
+
 ValuePtr PlusLink::kons(AtomSpace* as, bool silent,
                         const ValuePtr& fi, const ValuePtr& fj) const
 {
 	if (fj == knil)
 		return NumericFunctionLink::get_value(as, silent, fi);
 
+	if (TIMES_LINK == fi->get_type())
+	{
+		ValuePtr vsum(fuse_times(as, silent, HandleCast(fi), fj));
+		if (vsum) return vsum;
+	}
+
 	// Try to yank out values, if possible.
 	ValuePtr vi(NumericFunctionLink::get_value(as, silent, fi));
 	Type vitype = vi->get_type();
@@ -0,0 +1,349 @@
+/*
+ * opencog/atoms/reduct/VectorKernel.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/CompactArith.h>
+#include <opencog/atoms/value/FloatKernels.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include "VectorKernel.h"
+
+using namespace opencog;
+
+bool VectorKernel::enabled = true;
+
+VectorKernel::VectorKernel(void) :
+	_nregs(0)
+{
+}
+
+// ===========================================================
+
+void VectorKernel::push(Op op, size_t dst, size_t a, size_t b)
+{
+	_code.push_back({op, (uint8_t) (MAX_INPUTS + dst),
+	                 (uint8_t) a, (uint8_t) b});
+	_nregs = std::max(_nregs, dst + 1);
+}
+
+/// The inputs are fetched, not computed: looking at them costs little,
+/// and has no side effects, so that, if they turn out not to fit, the
+/// tree walk can fetch them again.
+static bool is_input(Type t)
+{
+	return NUMBER_NODE == t or VALUE_OF_LINK == t or
+		FLOAT_VALUE_OF_LINK == t;
+}
+
+static bool is_zero(const Handle& h)
+{
+	if (NUMBER_NODE != h->get_type()) return false;
+	NumberNodePtr nn(NumberNodeCast(h));
+	return 1 == nn->size() and 0.0 == nn->get_value();
+}
+
+/// A right fold, as in FoldLink::delta_reduce(): the last operand
+/// first, then each operand, right to left, combined with the result
+/// so far. `slot` is where the result is: register `reg`, or, if
+/// there is only one operand, that operand.
+bool VectorKernel::emit_fold(const HandleSeq& oset, Op op,
+                             size_t reg, size_t& slot)
+{
+	if (0 == oset.size()) return false;
+
+	size_t acc;
+	if (not emit(oset.back(), reg, acc)) return false;
+	for (size_t i = oset.size() - 1; 0 < i; i--)
+	{
+		size_t x;
+		if (not emit(oset[i-1], reg+1, x)) return false;
+		push(op, reg, x, acc);
+		acc = MAX_INPUTS + reg;
+	}
+	slot = acc;
+	return true;
+}
+
+/// Compile `h` so that its value ends up in register `reg`, or, for
+/// an input, in the input slot; the registers above `reg` are scratch.
+bool VectorKernel::emit(const Handle& h, size_t reg, size_t& slot)
+{
+	// Leave room for the scratch register of a fold.
+	if (MAX_REGS <= reg + 1) return false;
+
+	Type t = h->get_type();
+	if (is_input(t))
+	{
+		if (MAX_INPUTS <= _inputs.size()) return false;
+		slot = _inputs.size();
+		_inputs.push_back(h);
+		return true;
+	}
+
+	if (not h->is_link()) return false;
+	const HandleSeq& oset = h->getOutgoingSet();
+
+	// ArithmeticLink::reorder() puts the expressions first, then the
+	// numbers. Adding a zero is skipped, as PlusLink::kons() skips it;
+	// that matters only for the sign of a zero sum.
+	if (PLUS_LINK == t or TIMES_LINK == t)
+	{
+		HandleSeq ordered;
+		for (const Handle& ho : oset)
+			if (NUMBER_NODE != ho->get_type())
+				ordered.push_back(ho);
+		for (const Handle& ho : oset)
+		{
+			if (NUMBER_NODE != ho->get_type()) continue;
+			if (PLUS_LINK == t and is_zero(ho)) continue;
+			ordered.push_back(ho);
+		}
+		if (0 == ordered.size() and 0 < oset.size())
+			ordered.push_back(oset.back());
+		return emit_fold(ordered, PLUS_LINK == t ? ADD : MUL, reg, slot);
+	}
+
+	// The unary forms already have the 0 or 1 inserted; subtracting
+	// the final zero and dividing by the final one are exact.
+	if (MINUS_LINK == t) return emit_fold(oset, SUB, reg, slot);
+	if (DIVIDE_LINK == t) return emit_fold(oset, DIV, reg, slot);
+
+	if (POW_LINK == t)
+	{
+		if (2 != oset.size()) return false;
+		size_t x, y;
+		if (not emit(oset[0], reg, x)) return false;
+		if (not emit(oset[1], reg+1, y)) return false;
+		push(POW, reg, x, y);
+		slot = MAX_INPUTS + reg;
+		return true;
+	}
+
+	Op op;
+	if (FLOOR_LINK == t) op = FLOOR;
+	else if (HEAVISIDE_LINK == t) op = HEAVISIDE;
+	else if (LOG2_LINK == t) op = LOG2;
+	else if (SINE_LINK == t) op = SIN;
+	else if (COSINE_LINK == t) op = COS;
+	else if (TAN_LINK == t) op = TAN;
+	else if (EXP_LINK == t) op = EXP;
+	else return false;
+
+	if (1 != oset.size()) return false;
+	size_t x;
+	if (not emit(oset[0], reg, x)) return false;
+	push(op, reg, x);
+	slot = MAX_INPUTS + reg;
+	return true;
+}
+
+VectorKernel* VectorKernel::compile(const Handle& body)
+{
+	if (not enabled) return nullptr;
+
+	VectorKernel* vk = new VectorKernel();
+	size_t slot;
+	if (not vk->emit(body, 0, slot) or vk->_code.size() < 2)
+	{
+		delete vk;
+		return nullptr;
+	}
+	return vk;
+}
+
+// ===========================================================
+
+template<double (*FN)(double)>
+static void apply(double* out, const double* a, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = FN(a[i]);
+}
+
+static double impulse(double x) { return 1-std::signbit(x); }
+static double floor_(double x) { return floor(x); }
+static double log2_(double x) { return log2(x); }
+static double sin_(double x) { return sin(x); }
+static double cos_(double x) { return cos(x); }
+static double tan_(double x) { return tan(x); }
+static double exp_(double x) { return exp(x); }
+
+/// Run the code over the inputs, one block at a time. The last
+/// instruction writes straight into `out`.
+void VectorKernel::run(const std::vector<const double*>& data,
+                       const std::vector<bool>& scalar,
+                       double* out, size_t len) const
+{
+	size_t nin = _inputs.size();
+	size_t blk = (len < BLOCK) ? len : BLOCK;
+
+	// The registers, then a block of copies of each scalar input.
+	std::vector<double> scratch((_nregs + nin) * blk);
+	const double* src[MAX_INPUTS + MAX_REGS] = {};
+	double* reg[MAX_REGS];
+	for (size_t r = 0; r < _nregs; r++)
+		reg[r] = scratch.data() + r * blk;
+	for (size_t k = 0; k < nin; k++)
+	{
+		if (not scalar[k]) continue;
+		double* bcast = scratch.data() + (_nregs + k) * blk;
+		std::fill(bcast, bcast + blk, data[k][0]);
+		src[k] = bcast;
+	}
+
+	size_t last = _code.size() - 1;
+	for (size_t i = 0; i < len; i += blk)
+	{
+		size_t n = std::min(blk, len - i);
+		for (size_t k = 0; k < nin; k++)
+			if (not scalar[k]) src[k] = data[k] + i;
+
+		for (size_t pc = 0; pc <= last; pc++)
+		{
+			const Insn& in = _code[pc];
+			double* d = (pc == last) ? out + i : reg[in.dst - MAX_INPUTS];
+			const double* a = src[in.a];
+			const double* b = src[in.b];
+			switch (in.op)
+			{
+				case ADD: vec_add(d, a, b, n); break;
+				case SUB: vec_sub(d, a, b, n); break;
+				case MUL: vec_mul(d, a, b, n); break;
+				case DIV: vec_div(d, a, b, n); break;
+				case POW:
+					for (size_t j = 0; j < n; j++) d[j] = pow(a[j], b[j]);
+					break;
+				case FLOOR: apply<floor_>(d, a, n); break;
+				case HEAVISIDE: apply<impulse>(d, a, n); break;
+				case LOG2: apply<log2_>(d, a, n); break;
+				case SIN: apply<sin_>(d, a, n); break;
+				case COS: apply<cos_>(d, a, n); break;
+				case TAN: apply<tan_>(d, a, n); break;
+				case EXP: apply<exp_>(d, a, n); break;
+			}
+			src[in.dst] = d;
+		}
+	}
+}
+
+ValuePtr VectorKernel::execute(AtomSpace* as, bool silent) const
+{
+	size_t nin = _inputs.size();
+	ValueSeq vals(nin);
+	std::vector<FloatSpan> spans(nin);
+	std::vector<const double*> data(nin);
+	std::vector<bool> scalar(nin);
+
+	size_t len = 1;
+	bool number = true;
+	for (size_t k = 0; k < nin; k++)
+	{
+		ValuePtr vp(FunctionLink::get_value(as, silent, _inputs[k]));
+		Type t = vp->get_type();
+
+		FloatSpan v;
+		if (NUMBER_NODE == t)
+			v = NumberNodeCast(vp)->value();
+		else if (is_compact(t))
+		{
+			// Done in their own precision by the tree walk.
+			return nullptr;
+		}
+		else if (nameserver().isA(t, STREAM_VALUE))
+		{
+			// Looking at a stream samples it; if some later input
+			// did not fit, the tree walk would sample it again.
+			return nullptr;
+		}
+		else if (nameserver().isA(t, FLOAT_VALUE))
+		{
+			v = FloatValueCast(vp)->span();
+			number = false;
+		}
+		else return nullptr;
+
+		// Vectors of unequal length are padded by the tree walk.
+		size_t n = v.size();
+		if (0 == n) return nullptr;
+		if (1 < n)
+		{
+			if (1 < len and n != len) return nullptr;
+			len = n;
+		}
+
+		// The span keeps a copy alive, if one had to be made.
+		vals[k] = vp;
+		spans[k] = v;
+		data[k] = v.data();
+		scalar[k] = (1 == n);
+	}
+
+	std::vector<double> out(len);
+	run(data, scalar, out.data(), len);
+
+	// Only NumberNodes in gives a NumberNode out, as in the tree walk.
+	if (number)
+		return createNumberNode(std::move(out));
+	return createFloatValue(std::move(out));
+}
+
+// ===========================================================
+
+VectorKernelCache::VectorKernelCache(void) :
+	_kernel(nullptr), _failed(false)
+{
+}
+
+VectorKernelCache::~VectorKernelCache()
+{
+	delete _kernel.load();
+}
+
+const VectorKernel* VectorKernelCache::get(const Handle& body)
+{
+	if (not VectorKernel::enabled) return nullptr;
+	const VectorKernel* vk = _kernel.load(std::memory_order_acquire);
+	if (vk) return vk;
+	if (_failed.load(std::memory_order_relaxed)) return nullptr;
+
+	vk = VectorKernel::compile(body);
+	if (nullptr == vk)
+	{
+		_failed = true;
+		return nullptr;
+	}
+
+	// Two threads may have compiled it at once; keep the first.
+	const VectorKernel* expect = nullptr;
+	if (not _kernel.compare_exchange_strong(expect, vk))
+	{
+		delete vk;
+		return expect;
+	}
+	return vk;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,158 @@
+/*
+ * opencog/atoms/reduct/VectorKernel.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_VECTOR_KERNEL_H
+#define _OPENCOG_VECTOR_KERNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * A VectorKernel evaluates a whole tree of arithmetic on vectors, such
+ * as (Divide (Plus a b) (Times c d)) with a, b, c and d FloatValues,
+ * in a single pass over the inputs. The tree walk makes a FloatValue
+ * for every link in the tree, each one a full pass over memory; the
+ * kernel instead runs the whole tree over one block of a few hundred
+ * elements at a time, keeping the intermediate results in small
+ * scratch blocks that stay in the L1 cache, and writes only the final
+ * result.
+ *
+ * The tree may hold Plus, Minus, Times, Divide, Pow and the unary
+ * NumericFunctionLinks, over NumberNodes and ValueOfLinks (and its
+ * FloatValueOf kin). The inputs must all be of the same length, or be
+ * scalars; the tree walk pads vectors of unequal length, and that is
+ * left to it. Streams are left to it, too: they are sampled when they
+ * are looked at, and the kernel cannot know if they fit until then.
+ * The arithmetic is done in the same order as the tree walk does it,
+ * so that the results are identical.
+ *
+ * This is the vector counterpart of the FormulaKernel, which handles
+ * scalar expressions with variables.
+ */
+class VectorKernel
+{
+public:
+	enum Op : uint8_t
+	{
+		ADD,          // r[dst] = r[a] op r[b]
+		SUB,
+		MUL,
+		DIV,
+		POW,
+		FLOOR,        // r[dst] = fn(r[a])
+		HEAVISIDE,
+		LOG2,
+		SIN,
+		COS,
+		TAN,
+		EXP,
+	};
+
+	// Operands below the number of inputs are inputs; the rest are
+	// scratch registers.
+	struct Insn
+	{
+		Op op;
+		uint8_t dst;
+		uint8_t a;
+		uint8_t b;
+	};
+
+	/// Elements per block.
+	static const size_t BLOCK = 256;
+
+	/// Trees nested deeper than this, or with more inputs, are not
+	/// compiled.
+	static const size_t MAX_REGS = 32;
+	static const size_t MAX_INPUTS = 200;
+
+	/// Set to false to always walk the tree; for benchmarking.
+	static bool enabled;
+
+private:
+	std::vector<Insn> _code;
+	HandleSeq _inputs;
+	size_t _nregs;
+
+	VectorKernel(void);
+	bool emit(const Handle&, size_t reg, size_t& slot);
+	bool emit_fold(const HandleSeq&, Op, size_t reg, size_t& slot);
+	size_t input(const Handle&);
+	void push(Op, size_t dst, size_t a, size_t b=0);
+
+	void run(const std::vector<const double*>&,
+	         const std::vector<bool>& scalar,
+	         double* out, size_t len) const;
+
+public:
+	/// Compile the expression. Returns nullptr if it is not a tree of
+	/// vector arithmetic, or if it is too small to gain anything from
+	/// being fused (a single link).
+	static VectorKernel* compile(const Handle&);
+
+	/// Evaluate the inputs and run the tree over them. Returns nullptr
+	/// if the inputs are not numeric vectors that fit together; the
+	/// caller must then walk the tree instead.
+	ValuePtr execute(AtomSpace*, bool silent) const;
+
+	/// The number of instructions.
+	size_t size(void) const { return _code.size(); }
+};
+
+/**
+ * The VectorKernel of one expression, kept with the Atom holding the
+ * expression, as KernelCache does for the FormulaKernel. Unlike that
+ * one, it is compiled the first time that it is asked for: a tree of
+ * vector arithmetic gains from being fused even if it is run once.
+ */
+class VectorKernelCache
+{
+	std::atomic<const VectorKernel*> _kernel;
+	std::atomic<bool> _failed;
+
+public:
+	VectorKernelCache(void);
+	VectorKernelCache(const VectorKernelCache&) = delete;
+	VectorKernelCache& operator=(const VectorKernelCache&) = delete;
+	~VectorKernelCache();
+
+	/// The kernel for `body`, compiling it if need be; nullptr if
+	/// it does not compile.
+	const VectorKernel* get(const Handle& body);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_VECTOR_KERNEL_H
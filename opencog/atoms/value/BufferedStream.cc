@@ -0,0 +1,180 @@
+/*
+ * opencog/atoms/value/BufferedStream.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/value/BufferedStream.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+BufferedStream::BufferedStream(size_t block, size_t nblocks) :
+	StreamValue(BUFFERED_STREAM),
+	_block(block), _head(0), _tail(0), _closed(false), _reading(false)
+{
+	if (0 == block or 0 == nblocks)
+		throw RuntimeException(TRACE_INFO,
+			"BufferedStream needs at least one block of one sample");
+	_ring.resize(block * nblocks);
+}
+
+static size_t nth(const std::vector<double>& v, size_t i, size_t dflt)
+{
+	if (v.size() <= i) return dflt;
+	if (not (1.0 <= v[i]))
+		throw RuntimeException(TRACE_INFO,
+			"BufferedStream sizes must be positive, got %g", v[i]);
+	return v[i];
+}
+
+BufferedStream::BufferedStream(const std::vector<double>& v) :
+	BufferedStream(nth(v, 0, 4096), nth(v, 1, 16))
+{}
+
+// ==============================================================
+
+/// Copy in as many samples as fit, and wake the readers.
+/// The lock must be held.
+size_t BufferedStream::put(const double* p, size_t n)
+{
+	size_t cap = _ring.size();
+	n = std::min<uint64_t>(n, cap - (_head - _tail));
+	if (0 == n) return 0;
+
+	size_t at = _head % cap;
+	size_t first = std::min(n, cap - at);
+	memcpy(_ring.data() + at, p, first * sizeof(double));
+	memcpy(_ring.data(), p + first, (n - first) * sizeof(double));
+	_head += n;
+
+	_readable.notify_all();
+	return n;
+}
+
+void BufferedStream::write(const FloatSpan& samples)
+{
+	const double* p = samples.data();
+	size_t n = samples.size();
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (true)
+	{
+		if (_closed)
+			throw RuntimeException(TRACE_INFO,
+				"Cannot write to a closed BufferedStream");
+
+		// Fill whatever room there is, so that a reader waiting for
+		// a full ring is never stuck behind us.
+		size_t done = put(p, n);
+		p += done;
+		n -= done;
+		if (0 == n) return;
+
+		// Then wait for a whole block to be freed up.
+		size_t want = std::min(n, _block);
+		_writable.wait(lck, [&]() {
+			return _closed or _ring.size() - (_head - _tail) >= want; });
+	}
+}
+
+size_t BufferedStream::try_write(const FloatSpan& samples)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (_closed)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot write to a closed BufferedStream");
+	return put(samples.data(), samples.size());
+}
+
+void BufferedStream::close(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_closed = true;
+	_readable.notify_all();
+	_writable.notify_all();
+}
+
+bool BufferedStream::is_closed(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _closed;
+}
+
+size_t BufferedStream::available(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _head - _tail;
+}
+
+// ==============================================================
+
+FloatSpan BufferedStream::read_chunk(size_t max, size_t min)
+{
+	size_t cap = _ring.size();
+
+	// Asking for more than the ring can hold would wait forever.
+	min = std::min(min, std::min(max, cap));
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	if (_reading)
+		throw RuntimeException(TRACE_INFO,
+			"BufferedStream can only have one reader at a time");
+	_reading = true;
+	_readable.wait(lck, [&]() { return _closed or _head - _tail >= min; });
+	_reading = false;
+
+	size_t n = std::min<uint64_t>(max, _head - _tail);
+	size_t at = _tail % cap;
+	size_t first = std::min(n, cap - at);
+	_value.resize(n);
+	memcpy(_value.data(), _ring.data() + at, first * sizeof(double));
+	memcpy(_value.data() + first, _ring.data(), (n - first) * sizeof(double));
+	_tail += n;
+
+	_writable.notify_all();
+	return FloatSpan(_value);
+}
+
+// ==============================================================
+
+std::string BufferedStream::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	rv += " " + std::to_string(_block);
+	rv += " " + std::to_string(_ring.size() / _block);
+	rv += ")\n" + indent + "; Last chunk read:\n";
+
+	// The reader might be reading the next chunk into it, just now.
+	std::lock_guard<std::mutex> lck(_mtx);
+	rv += indent + "; " + FloatValue::to_string("", FLOAT_VALUE);
+	return rv;
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_VALUE_FACTORY(BUFFERED_STREAM,
+                     createBufferedStream, std::vector<double>)
@@ -0,0 +1,134 @@
+/*
+ * opencog/atoms/value/BufferedStream.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BUFFERED_STREAM_H
+#define _OPENCOG_BUFFERED_STREAM_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <opencog/atoms/value/StreamValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * BufferedStream is a loss-less stream of samples: producers write()
+ * them in, consumers read_chunk() them out, each sample exactly once,
+ * in the order written. It is meant for sensor-like data arriving at
+ * high rates, that must be processed a batch at a time, and not one
+ * number at a time.
+ *
+ * The samples are held in a ring of fixed-size blocks. A writer
+ * blocks when the ring is full, until a reader has made room for a
+ * whole block (or for all of what remains to be written, if that is
+ * less); this is the backpressure that keeps a fast producer from
+ * running away from a slow consumer. A reader blocks until there are
+ * enough samples for it, or until the stream is closed.
+ *
+ * There may be any number of writers, but only one reader: the
+ * chunk handed back by read_chunk() lives in the stream itself, and
+ * is overwritten by the next read. A read_chunk() that starts while
+ * another one is still in progress throws. If several threads need
+ * the samples, one of them should read, and hand out copies.
+ *
+ * The current value() is the last chunk that was read; like the span
+ * returned by read_chunk(), it belongs to the reader, and is good
+ * until the reader reads again. Reading does not happen behind the
+ * caller's back: update() does nothing, so that printing the stream
+ * does not lose any samples.
+ */
+class BufferedStream
+	: public StreamValue
+{
+protected:
+	// The unread samples are _ring[_tail % cap] .. _ring[_head % cap].
+	std::vector<double> _ring;
+	size_t _block;
+	uint64_t _head;
+	uint64_t _tail;
+	bool _closed;
+	bool _reading;
+
+	mutable std::mutex _mtx;
+	std::condition_variable _readable;
+	std::condition_variable _writable;
+
+	size_t put(const double*, size_t);
+
+	virtual void update() const {}
+
+public:
+	BufferedStream(size_t block = 4096, size_t nblocks = 16);
+
+	/// The block size, then the number of blocks.
+	BufferedStream(const std::vector<double>&);
+
+	virtual ~BufferedStream() {}
+
+	/// Append the samples, waiting for room as needed.
+	void write(const FloatSpan&);
+
+	/// Append as many of the samples as there is room for, without
+	/// waiting. Returns how many that was.
+	size_t try_write(const FloatSpan&);
+
+	/// Tell the readers that nothing more will be written.
+	void close(void);
+	bool is_closed(void) const;
+
+	/// Samples written but not yet read.
+	size_t available(void) const;
+	size_t capacity(void) const { return _ring.size(); }
+	size_t block_size(void) const { return _block; }
+
+	virtual FloatSpan read_chunk(size_t max, size_t min = 1);
+
+	/// Read the next block, or what there is, at the end.
+	FloatSpan read_chunk(void) { return read_chunk(_block); }
+
+	virtual bool is_chunked(void) const { return true; }
+	virtual size_t max_chunk(void) const { return capacity(); }
+
+	/** Returns a string representation of the value.  */
+	virtual std::string to_string(const std::string& indent = "") const;
+};
+
+typedef std::shared_ptr<BufferedStream> BufferedStreamPtr;
+static inline BufferedStreamPtr BufferedStreamCast(ValuePtr& a)
+	{ return std::dynamic_pointer_cast<BufferedStream>(a); }
+
+template<typename ... Type>
+static inline std::shared_ptr<BufferedStream> createBufferedStream(Type&&... args) {
+	return std::make_shared<BufferedStream>(std::forward<Type>(args)...);
+}
+
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_BUFFERED_STREAM_H
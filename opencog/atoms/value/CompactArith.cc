@@ -0,0 +1,201 @@
+/*
+ * opencog/atoms/value/CompactArith.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include <opencog/atoms/value/CompactArith.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+/// Apply `fn` pointwise, in the working precision W, storing as T.
+/// A vector of length one is a scalar; otherwise the shorter vector
+/// is padded with `pad`. Returns true if some result did not fit in T.
+template<typename T, typename W, typename A, typename B, typename F>
+static bool combine(std::vector<T>& out, const A* a, size_t na,
+                    const B* b, size_t nb, W pad, F fn)
+{
+	bool over = false;
+	auto put = [&](size_t i, W w)
+	{
+		out[i] = (T) w;
+		if constexpr (not std::is_same<T, W>::value)
+			over |= (w != (W) (T) w);
+	};
+
+	if (1 == na and 1 != nb)
+	{
+		W x = a[0];
+		out.resize(nb);
+		for (size_t i=0; i<nb; i++) put(i, fn(x, (W) b[i]));
+		return over;
+	}
+	if (1 == nb and 1 != na)
+	{
+		W y = b[0];
+		out.resize(na);
+		for (size_t i=0; i<na; i++) put(i, fn((W) a[i], y));
+		return over;
+	}
+
+	size_t m = std::min(na, nb);
+	out.resize(std::max(na, nb));
+	for (size_t i=0; i<m; i++) put(i, fn((W) a[i], (W) b[i]));
+	for (size_t i=m; i<na; i++) put(i, fn((W) a[i], pad));
+	for (size_t i=m; i<nb; i++) put(i, fn(pad, (W) b[i]));
+	return over;
+}
+
+template<typename T, typename W, typename A, typename B>
+static bool arith(ArithOp op, std::vector<T>& out,
+                  const A* a, size_t na, const B* b, size_t nb)
+{
+	switch (op)
+	{
+		case ARITH_PLUS:
+			return combine<T>(out, a, na, b, nb, W(0),
+				[](W x, W y) { return x + y; });
+		case ARITH_MINUS:
+			return combine<T>(out, a, na, b, nb, W(0),
+				[](W x, W y) { return x - y; });
+		case ARITH_TIMES:
+			return combine<T>(out, a, na, b, nb, W(1),
+				[](W x, W y) { return x * y; });
+		case ARITH_DIVIDE:
+			return combine<T>(out, a, na, b, nb, W(1),
+				[](W x, W y) { return x / y; });
+	}
+	return false;
+}
+
+// ==============================================================
+
+// The numbers of a compact value; one of the pointers is null.
+struct Nums
+{
+	const float* f;
+	const uint32_t* u;
+	size_t n;
+};
+
+static Nums nums(const FloatValuePtr& fvp)
+{
+	if (FLOAT32_VALUE == fvp->get_type())
+	{
+		const std::vector<float>& v(((const Float32Value*) fvp.get())->value32());
+		return {v.data(), nullptr, v.size()};
+	}
+	const std::vector<uint32_t>& v(((const UInt32Value*) fvp.get())->value32());
+	return {nullptr, v.data(), v.size()};
+}
+
+/// At least one of them is a Float32Value. A UInt32 does not always
+/// fit in a float; the two are combined in double precision, and the
+/// result is rounded just once.
+static ValuePtr floats(ArithOp op, const Nums& a, const Nums& b)
+{
+	std::vector<float> out;
+	if (a.f and b.f)
+		arith<float, float>(op, out, a.f, a.n, b.f, b.n);
+	else if (a.f)
+		arith<float, double>(op, out, a.f, a.n, b.u, b.n);
+	else
+		arith<float, double>(op, out, a.u, a.n, b.f, b.n);
+	return createFloat32Value(std::move(out));
+}
+
+/// Both of them are UInt32Values. Sums and products are done in 64
+/// bits, so that an overflow can be seen, and then done over again
+/// in double precision.
+static ValuePtr counts(ArithOp op, const Nums& a, const Nums& b)
+{
+	if (ARITH_PLUS == op or ARITH_TIMES == op)
+	{
+		std::vector<uint32_t> out;
+		if (not arith<uint32_t, uint64_t>(op, out, a.u, a.n, b.u, b.n))
+			return createUInt32Value(std::move(out));
+	}
+
+	std::vector<double> out;
+	arith<double, double>(op, out, a.u, a.n, b.u, b.n);
+	return createFloatValue(std::move(out));
+}
+
+// ==============================================================
+
+ValuePtr opencog::compact_arith(ArithOp op, const FloatValuePtr& a,
+                                const FloatValuePtr& b)
+{
+	if (not is_compact(a->get_type()) or not is_compact(b->get_type()))
+		return nullptr;
+
+	Nums na(nums(a));
+	Nums nb(nums(b));
+	if (na.u and nb.u) return counts(op, na, nb);
+	return floats(op, na, nb);
+}
+
+/// The scalar as a compact vector of length one, if it can be one
+/// without rounding it.
+static bool narrow(double s, Type t, float& f, uint32_t& u, Nums& ns)
+{
+	if (FLOAT32_VALUE == t and (double) (float) s == s)
+	{
+		f = s;
+		ns = {&f, nullptr, 1};
+		return true;
+	}
+	if (UINT32_VALUE == t and 0.0 <= s and s <= UINT32_MAX and s == floor(s))
+	{
+		u = s;
+		ns = {nullptr, &u, 1};
+		return true;
+	}
+	return false;
+}
+
+ValuePtr opencog::compact_arith(ArithOp op, double s, const FloatValuePtr& b)
+{
+	float f;
+	uint32_t u;
+	Nums ns;
+	if (not narrow(s, b->get_type(), f, u, ns)) return nullptr;
+
+	Nums nb(nums(b));
+	if (ns.u) return counts(op, ns, nb);
+	return floats(op, ns, nb);
+}
+
+ValuePtr opencog::compact_arith(ArithOp op, const FloatValuePtr& a, double s)
+{
+	float f;
+	uint32_t u;
+	Nums ns;
+	if (not narrow(s, a->get_type(), f, u, ns)) return nullptr;
+
+	Nums na(nums(a));
+	if (ns.u) return counts(op, na, ns);
+	return floats(op, na, ns);
+}
@@ -0,0 +1,73 @@
+/*
+ * opencog/atoms/value/CompactArith.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_COMPACT_ARITH_H
+#define _OPENCOG_COMPACT_ARITH_H
+
+#include <opencog/atoms/value/Float32Value.h>
+#include <opencog/atoms/value/UInt32Value.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Arithmetic on Float32Values and UInt32Values, done in their own
+ * precision, without widening them to doubles first. The shorter
+ * vector is padded, and a vector of length one is a scalar, exactly
+ * as for FloatValues.
+ *
+ * The type of the result:
+ *
+ *   Float32 op Float32          -> Float32
+ *   Float32 op UInt32           -> Float32, worked out in double
+ *   UInt32 plus/times UInt32    -> UInt32, or FloatValue if it does
+ *                                  not fit in 32 bits
+ *   UInt32 minus/divide UInt32  -> FloatValue
+ *   Float32 op float scalar     -> Float32
+ *   UInt32 op whole scalar      -> as for UInt32 op UInt32
+ *
+ * A scalar is a single number, such as (Number 2); a float scalar is
+ * one that fits in single precision as it is. Anything else
+ * together with a double-precision vector is done in double precision,
+ * and gives a FloatValue; for those, these functions return nullptr,
+ * and the caller must do the arithmetic on FloatValue::span().
+ */
+enum ArithOp { ARITH_PLUS, ARITH_MINUS, ARITH_TIMES, ARITH_DIVIDE };
+
+/// Is this a Float32Value or a UInt32Value?
+static inline bool is_compact(Type t)
+{
+	return FLOAT32_VALUE == t or UINT32_VALUE == t;
+}
+
+ValuePtr compact_arith(ArithOp, const FloatValuePtr&, const FloatValuePtr&);
+ValuePtr compact_arith(ArithOp, double, const FloatValuePtr&);
+ValuePtr compact_arith(ArithOp, const FloatValuePtr&, double);
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_COMPACT_ARITH_H
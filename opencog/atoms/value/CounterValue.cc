@@ -0,0 +1,172 @@
+/*
+ * opencog/atoms/value/CounterValue.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/value/CounterValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+CounterValue::Chunk::Chunk(size_t base, size_t len) :
+	_base(base), _len(len),
+	_slots(new std::atomic<double>[len]), _next(nullptr)
+{
+	for (size_t i=0; i<len; i++)
+		_slots[i].store(0.0, std::memory_order_relaxed);
+}
+
+CounterValue::Chunk::~Chunk()
+{
+	delete _next.load(std::memory_order_relaxed);
+}
+
+// ==============================================================
+
+CounterValue::CounterValue(const std::vector<double>& v) :
+	CounterValue(COUNTER_VALUE, v)
+{}
+
+CounterValue::CounterValue(Type t, const std::vector<double>& v) :
+	FloatValue(t), _head(0, v.size()), _size(v.size())
+{
+	for (size_t i=0; i<v.size(); i++)
+		_head._slots[i].store(v[i], std::memory_order_relaxed);
+}
+
+// ==============================================================
+
+/// Return slot `idx`, creating it if needed. Chunks are only ever
+/// appended, so this is lock-free; if two threads race to append,
+/// the loser throws its chunk away.
+std::atomic<double>& CounterValue::slot(size_t idx) const
+{
+	Chunk* c = &_head;
+	while (c->_base + c->_len <= idx)
+	{
+		Chunk* next = c->_next.load(std::memory_order_acquire);
+		if (nullptr == next)
+		{
+			// Double the size, at least, so the list stays short.
+			size_t base = c->_base + c->_len;
+			Chunk* fresh = new Chunk(base, std::max(idx + 1 - base, base));
+			if (c->_next.compare_exchange_strong(next, fresh,
+			        std::memory_order_acq_rel))
+				next = fresh;
+			else
+				delete fresh;
+		}
+		c = next;
+	}
+
+	size_t sz = _size.load(std::memory_order_relaxed);
+	while (sz <= idx and
+	       not _size.compare_exchange_weak(sz, idx + 1,
+	               std::memory_order_relaxed))
+		;
+
+	return c->_slots[idx - c->_base];
+}
+
+double CounterValue::fetch_add(size_t idx, double delta) const
+{
+	// No fetch_add for atomic<double> until C++20.
+	std::atomic<double>& s = slot(idx);
+	double old = s.load(std::memory_order_relaxed);
+	while (not s.compare_exchange_weak(old, old + delta,
+	               std::memory_order_relaxed))
+		;
+	return old + delta;
+}
+
+double CounterValue::get(size_t idx) const
+{
+	if (_size.load(std::memory_order_relaxed) <= idx) return 0.0;
+	return slot(idx).load(std::memory_order_relaxed);
+}
+
+// ==============================================================
+
+/// A snapshot of the counts, for value() and span(). It is a copy of
+/// its own, so that the counts changing, or growing, cannot pull it
+/// out from under the caller.
+FloatSpan CounterValue::span() const
+{
+	size_t sz = _size.load(std::memory_order_relaxed);
+	std::vector<double> snap(sz);
+	for (size_t i=0; i<sz; i++)
+		snap[i] = slot(i).load(std::memory_order_relaxed);
+	return FloatSpan(std::move(snap));
+}
+
+size_t CounterValue::size() const
+{
+	return _size.load(std::memory_order_relaxed);
+}
+
+ValuePtr CounterValue::value_at_index(size_t idx) const
+{
+	return createFloatValue(get(idx));
+}
+
+// ==============================================================
+
+/// Add, in place, and return this very same CounterValue.
+ValuePtr CounterValue::incrementCount(const std::vector<double>& v) const
+{
+	for (size_t idx=0; idx < v.size(); idx++)
+		fetch_add(idx, v[idx]);
+	return std::const_pointer_cast<Value>(shared_from_this());
+}
+
+ValuePtr CounterValue::incrementCount(size_t idx, double count) const
+{
+	fetch_add(idx, count);
+	return std::const_pointer_cast<Value>(shared_from_this());
+}
+
+// ==============================================================
+
+bool CounterValue::operator==(const Value& other) const
+{
+	if (this == &other) return true;
+	if (not other.is_type(FLOAT_VALUE)) return false;
+	return FloatValue::equal(span(), ((const FloatValue&) other).span());
+}
+
+std::string CounterValue::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	for (double v : span())
+	{
+		char buf[40];
+		snprintf(buf, 40, "%.16g", v);
+		rv += std::string(" ") + buf;
+	}
+	rv += ")";
+	return rv;
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_VALUE_FACTORY(COUNTER_VALUE, createCounterValue, std::vector<double>)
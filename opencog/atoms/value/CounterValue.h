@@ -0,0 +1,119 @@
+/*
+ * opencog/atoms/value/CounterValue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_COUNTER_VALUE_H
+#define _OPENCOG_COUNTER_VALUE_H
+
+#include <atomic>
+#include <memory>
+
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * CounterValues are FloatValues that are changed in place.
+ *
+ * Incrementing a FloatValue makes a brand new FloatValue, and so the
+ * Atom holding it must be locked while the old one is swapped out.
+ * When many threads are counting the same pairs, that lock is the
+ * bottleneck. A CounterValue, instead, keeps each slot in an atomic
+ * double, and `incrementCount()` adds to it, in place, without any
+ * locks; it returns itself.
+ *
+ * Each slot is updated atomically; an increment of several slots at
+ * once is not: a reader might see some of them, but not the rest.
+ * The slots never move, once created, so that growing the vector
+ * cannot lose an increment that is in flight.
+ *
+ * `value()` and `span()` return a snapshot of the counts, made when
+ * they are called, and not changed after; use `get()` to read just
+ * one slot.
+ */
+class CounterValue
+	: public FloatValue
+{
+protected:
+	// The slots are held in a list of chunks, so that growing does
+	// not move them.
+	struct Chunk
+	{
+		size_t _base;
+		size_t _len;
+		std::unique_ptr<std::atomic<double>[]> _slots;
+		std::atomic<Chunk*> _next;
+
+		Chunk(size_t base, size_t len);
+		~Chunk();
+	};
+
+	mutable Chunk _head;
+
+	// One more than the highest slot ever touched.
+	mutable std::atomic<size_t> _size;
+
+	std::atomic<double>& slot(size_t) const;
+
+public:
+	CounterValue(const std::vector<double>&);
+	CounterValue(Type, const std::vector<double>&);
+	virtual ~CounterValue() {}
+
+	/// Atomically add `delta` to slot `idx`; return the new count.
+	/// This is const, as the counts are mutable, just like the
+	/// samples in a StreamValue.
+	double fetch_add(size_t idx, double delta) const;
+
+	/// Return the current count in slot `idx`.
+	double get(size_t idx) const;
+
+	virtual FloatSpan span() const;
+	virtual size_t size() const;
+
+	virtual ValuePtr value_at_index(size_t) const;
+	virtual ValuePtr incrementCount(const std::vector<double>&) const;
+	virtual ValuePtr incrementCount(size_t, double) const;
+
+	virtual std::string to_string(const std::string& indent = "") const;
+
+	/** Returns true if two values are equal. */
+	virtual bool operator==(const Value&) const;
+};
+
+typedef std::shared_ptr<const CounterValue> CounterValuePtr;
+static inline CounterValuePtr CounterValueCast(const ValuePtr& a)
+	{ return std::dynamic_pointer_cast<const CounterValue>(a); }
+
+template<typename ... Type>
+static inline std::shared_ptr<CounterValue> createCounterValue(Type&&... args) {
+	return std::make_shared<CounterValue>(std::forward<Type>(args)...);
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_COUNTER_VALUE_H
@@ -0,0 +1,137 @@
+/*
+ * opencog/atoms/value/Float32Value.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include <opencog/atoms/value/Float32Value.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+Float32Value::Float32Value(const std::vector<float>& v) :
+	FloatValue(FLOAT32_VALUE), _f32(v)
+{}
+
+Float32Value::Float32Value(std::vector<float>&& v) :
+	FloatValue(FLOAT32_VALUE), _f32(std::move(v))
+{}
+
+Float32Value::Float32Value(float v) :
+	FloatValue(FLOAT32_VALUE), _f32(1, v)
+{}
+
+Float32Value::Float32Value(const std::vector<double>& v) :
+	FloatValue(FLOAT32_VALUE), _f32(v.begin(), v.end())
+{}
+
+/// The numbers, widened, in a copy held by the span; for code that
+/// works on FloatValues. The arithmetic links use _f32 directly.
+FloatSpan Float32Value::span() const
+{
+	return FloatSpan(std::vector<double>(_f32.begin(), _f32.end()));
+}
+
+// ==============================================================
+
+ValuePtr Float32Value::value_at_index(size_t idx) const
+{
+	float f = 0.0f;
+	if (_f32.size() > idx) f = _f32[idx];
+	return createFloat32Value(f);
+}
+
+ValuePtr Float32Value::incrementCount(const std::vector<double>& v) const
+{
+	std::vector<float> new_vect = _f32;
+	if (new_vect.size() < v.size())
+		new_vect.resize(v.size(), 0.0f);
+
+	for (size_t idx=0; idx < v.size(); idx++)
+		new_vect[idx] += v[idx];
+
+	return createFloat32Value(std::move(new_vect));
+}
+
+ValuePtr Float32Value::incrementCount(size_t idx, double count) const
+{
+	std::vector<float> new_vect = _f32;
+	if (new_vect.size() <= idx)
+		new_vect.resize(idx+1, 0.0f);
+
+	new_vect[idx] += count;
+	return createFloat32Value(std::move(new_vect));
+}
+
+// ==============================================================
+
+bool Float32Value::operator==(const Value& other) const
+{
+	if (this == &other) return true;
+	if (not other.is_type(FLOAT_VALUE)) return false;
+
+	// Compare floats with ULPS, as FloatValue::operator==() does for
+	// doubles. Anything else is compared in double precision.
+	if (FLOAT32_VALUE == other.get_type())
+	{
+		const std::vector<float>& of(((const Float32Value&) other)._f32);
+		if (_f32.size() != of.size()) return false;
+		for (size_t i=0; i<_f32.size(); i++)
+		{
+			int32_t a, b;
+			memcpy(&a, &_f32[i], sizeof(a));
+			memcpy(&b, &of[i], sizeof(b));
+			if (4 < abs(a - b)) return false;
+		}
+		return true;
+	}
+
+	FloatSpan mine(span());
+	FloatSpan theirs(((const FloatValue&) other).span());
+	if (mine.size() != theirs.size()) return false;
+	for (size_t i=0; i<mine.size(); i++)
+		if ((float) mine[i] != (float) theirs[i]) return false;
+	return true;
+}
+
+std::string Float32Value::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	for (float f : _f32)
+	{
+		// Nine digits is enough to read back the same float.
+		char buf[40];
+		snprintf(buf, 40, "%.9g", f);
+		rv += std::string(" ") + buf;
+	}
+	rv += ")";
+	return rv;
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_VALUE_FACTORY(FLOAT32_VALUE,
+                     createFloat32Value, std::vector<double>)
+DEFINE_VALUE_FACTORY(FLOAT32_VALUE,
+                     createFloat32Value, std::vector<float>)
@@ -0,0 +1,90 @@
+/*
+ * opencog/atoms/value/Float32Value.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FLOAT32_VALUE_H
+#define _OPENCOG_FLOAT32_VALUE_H
+
+#include <vector>
+
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Float32Values hold an ordered vector of single-precision floats;
+ * half the size of a FloatValue, for embeddings and the like, where
+ * the extra precision buys nothing.
+ *
+ * The arithmetic links work on them directly; see CompactArith.h for
+ * what type the result has. Code written for FloatValues also works,
+ * through value() and span(): these widen the numbers to doubles, in
+ * a temporary copy, every time they are asked for; nothing is kept.
+ */
+class Float32Value
+	: public FloatValue
+{
+protected:
+	std::vector<float> _f32;
+
+public:
+	Float32Value(const std::vector<float>& v);
+	Float32Value(std::vector<float>&& v);
+	Float32Value(float v);
+
+	/// Narrowed to single precision. For the factory, and thus for
+	/// the sexpr reader.
+	Float32Value(const std::vector<double>& v);
+
+	virtual ~Float32Value() {}
+
+	const std::vector<float>& value32() const { return _f32; }
+	virtual FloatSpan span() const;
+	virtual size_t size() const { return _f32.size(); }
+
+	virtual ValuePtr value_at_index(size_t) const;
+	virtual ValuePtr incrementCount(const std::vector<double>&) const;
+	virtual ValuePtr incrementCount(size_t, double) const;
+
+	virtual std::string to_string(const std::string& indent = "") const;
+
+	/** Returns true if two values are equal. */
+	virtual bool operator==(const Value&) const;
+};
+
+typedef std::shared_ptr<const Float32Value> Float32ValuePtr;
+static inline Float32ValuePtr Float32ValueCast(const ValuePtr& a)
+	{ return std::dynamic_pointer_cast<const Float32Value>(a); }
+
+template<typename ... Type>
+static inline std::shared_ptr<Float32Value> createFloat32Value(Type&&... args) {
+	return std::make_shared<Float32Value>(std::forward<Type>(args)...);
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FLOAT32_VALUE_H
@@ -0,0 +1,320 @@
+/*
+ * opencog/atoms/value/FloatKernels.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include <opencog/atoms/value/FloatKernels.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define HAVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+using namespace opencog;
+
+// The hardware multiply-add rounds once, where the plain loop rounds
+// twice; it must not be used, or the levels would not agree.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#define KERNEL(ISA) __attribute__((target(ISA)))
+#define PLAIN_KERNEL
+#elif defined(__GNUC__)
+#define KERNEL(ISA) __attribute__((target(ISA), optimize("fp-contract=off")))
+#define PLAIN_KERNEL __attribute__((optimize("fp-contract=off")))
+#else
+#define PLAIN_KERNEL
+#endif
+
+// Outputs at least this long (8 MBytes) are written with streaming
+// stores; they would not stay in the cache anyway.
+static const size_t STREAM_MIN = 1 << 20;
+
+struct VecOps
+{
+	void (*add)(double*, const double*, const double*, size_t);
+	void (*sub)(double*, const double*, const double*, size_t);
+	void (*mul)(double*, const double*, const double*, size_t);
+	void (*div)(double*, const double*, const double*, size_t);
+	void (*add_s)(double*, double, const double*, size_t);
+	void (*sub_s)(double*, double, const double*, size_t);
+	void (*mul_s)(double*, double, const double*, size_t);
+	void (*div_s)(double*, double, const double*, size_t);
+	void (*sub_by)(double*, const double*, double, size_t);
+	void (*div_by)(double*, const double*, double, size_t);
+	void (*mul_add)(double*, const double*, const double*,
+	                const double*, size_t);
+	void (*scale_add)(double*, double, const double*,
+	                  const double*, size_t);
+};
+
+// ==============================================================
+// The plain loops.
+
+namespace plain {
+
+#define PLAIN_BINARY(NAME, OP)                                       \
+PLAIN_KERNEL static void NAME(double* out, const double* a,          \
+                              const double* b, size_t n)             \
+{                                                                    \
+	for (size_t i = 0; i < n; i++) out[i] = a[i] OP b[i];            \
+}                                                                    \
+PLAIN_KERNEL static void NAME##_s(double* out, double s,             \
+                                  const double* a, size_t n)         \
+{                                                                    \
+	for (size_t i = 0; i < n; i++) out[i] = s OP a[i];               \
+}
+
+PLAIN_BINARY(add, +)
+PLAIN_BINARY(sub, -)
+PLAIN_BINARY(mul, *)
+PLAIN_BINARY(div, /)
+
+PLAIN_KERNEL static void sub_by(double* out, const double* a, double s, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = a[i] - s;
+}
+
+PLAIN_KERNEL static void div_by(double* out, const double* a, double s, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = a[i] / s;
+}
+
+PLAIN_KERNEL static void mul_add(double* out, const double* a,
+                                 const double* b, const double* c, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = a[i] * b[i] + c[i];
+}
+
+PLAIN_KERNEL static void scale_add(double* out, double s,
+                                   const double* b, const double* c, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = s * b[i] + c[i];
+}
+
+static const VecOps ops = {
+	add, sub, mul, div, add_s, sub_s, mul_s, div_s,
+	sub_by, div_by, mul_add, scale_add };
+
+} // namespace plain
+
+// ==============================================================
+// The vector loops. The same code, for each vector width, written
+// with the GCC vector extensions; `STREAM` is the non-temporal store
+// for that width.
+
+#ifdef HAVE_X86_KERNELS
+
+// The scalar statement `SCALAR` and the vector expression `VECTOR`
+// compute element `i`; the vector one, W elements starting at `i`.
+#define VLOOP(SCALAR, VECTOR)                                        \
+	size_t i = 0;                                                    \
+	if (STREAM_MIN <= n)                                             \
+	{                                                                \
+		for (; i < n and 0 != ((uintptr_t) (out + i)) % sizeof(vd); i++) \
+			SCALAR;                                                  \
+		for (; i + W <= n; i += W) stream(out + i, VECTOR);          \
+		_mm_sfence();                                                \
+	}                                                                \
+	for (; i + W <= n; i += W) st(out + i, VECTOR);                  \
+	for (; i < n; i++) SCALAR;
+
+#define DEFINE_KERNELS(NS, ISA, BYTES, MTYPE, STREAM)                \
+namespace NS {                                                       \
+                                                                     \
+typedef double vd __attribute__((vector_size(BYTES)));               \
+static const size_t W = BYTES / sizeof(double);                      \
+                                                                     \
+KERNEL(ISA) static inline vd ld(const double* p)                     \
+	{ vd v; __builtin_memcpy(&v, p, sizeof(vd)); return v; }         \
+KERNEL(ISA) static inline void st(double* p, vd v)                   \
+	{ __builtin_memcpy(p, &v, sizeof(vd)); }                         \
+KERNEL(ISA) static inline void stream(double* p, vd v)               \
+	{ STREAM(p, (MTYPE) v); }                                        \
+                                                                     \
+KERNEL(ISA) static void add(double* out, const double* a,            \
+                            const double* b, size_t n)               \
+	{ VLOOP(out[i] = a[i] + b[i], ld(a+i) + ld(b+i)) }               \
+KERNEL(ISA) static void sub(double* out, const double* a,            \
+                            const double* b, size_t n)               \
+	{ VLOOP(out[i] = a[i] - b[i], ld(a+i) - ld(b+i)) }               \
+KERNEL(ISA) static void mul(double* out, const double* a,            \
+                            const double* b, size_t n)               \
+	{ VLOOP(out[i] = a[i] * b[i], ld(a+i) * ld(b+i)) }               \
+KERNEL(ISA) static void div(double* out, const double* a,            \
+                            const double* b, size_t n)               \
+	{ VLOOP(out[i] = a[i] / b[i], ld(a+i) / ld(b+i)) }               \
+                                                                     \
+KERNEL(ISA) static void add_s(double* out, double s,                 \
+                              const double* a, size_t n)             \
+	{ vd vs = vd{} + s; VLOOP(out[i] = s + a[i], vs + ld(a+i)) }     \
+KERNEL(ISA) static void sub_s(double* out, double s,                 \
+                              const double* a, size_t n)             \
+	{ vd vs = vd{} + s; VLOOP(out[i] = s - a[i], vs - ld(a+i)) }     \
+KERNEL(ISA) static void mul_s(double* out, double s,                 \
+                              const double* a, size_t n)             \
+	{ vd vs = vd{} + s; VLOOP(out[i] = s * a[i], vs * ld(a+i)) }     \
+KERNEL(ISA) static void div_s(double* out, double s,                 \
+                              const double* a, size_t n)             \
+	{ vd vs = vd{} + s; VLOOP(out[i] = s / a[i], vs / ld(a+i)) }     \
+KERNEL(ISA) static void sub_by(double* out, const double* a,         \
+                               double s, size_t n)                   \
+	{ vd vs = vd{} + s; VLOOP(out[i] = a[i] - s, ld(a+i) - vs) }     \
+KERNEL(ISA) static void div_by(double* out, const double* a,         \
+                               double s, size_t n)                   \
+	{ vd vs = vd{} + s; VLOOP(out[i] = a[i] / s, ld(a+i) / vs) }     \
+                                                                     \
+KERNEL(ISA) static void mul_add(double* out, const double* a,        \
+                                const double* b, const double* c,    \
+                                size_t n)                            \
+	{ VLOOP(out[i] = a[i] * b[i] + c[i],                             \
+	        ld(a+i) * ld(b+i) + ld(c+i)) }                           \
+KERNEL(ISA) static void scale_add(double* out, double s,             \
+                                  const double* b, const double* c,  \
+                                  size_t n)                          \
+	{ vd vs = vd{} + s;                                              \
+	  VLOOP(out[i] = s * b[i] + c[i], vs * ld(b+i) + ld(c+i)) }      \
+                                                                     \
+static const VecOps ops = {                                          \
+	add, sub, mul, div, add_s, sub_s, mul_s, div_s,                  \
+	sub_by, div_by, mul_add, scale_add };                            \
+}
+
+DEFINE_KERNELS(avx2, "avx2", 32, __m256d, _mm256_stream_pd)
+DEFINE_KERNELS(avx512, "avx512f", 64, __m512d, _mm512_stream_pd)
+
+#endif // HAVE_X86_KERNELS
+
+// ==============================================================
+// Dispatch
+
+static std::atomic<const VecOps*> _ops(nullptr);
+static std::atomic<SimdLevel> _level(SimdLevel::SCALAR);
+
+SimdLevel opencog::simd_supported(void)
+{
+#ifdef HAVE_X86_KERNELS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+	if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+	return SimdLevel::SCALAR;
+}
+
+void opencog::set_simd_level(SimdLevel level)
+{
+	SimdLevel best = simd_supported();
+	if (best < level) level = best;
+
+	const VecOps* ops = &plain::ops;
+#ifdef HAVE_X86_KERNELS
+	if (SimdLevel::AVX512 == level) ops = &avx512::ops;
+	else if (SimdLevel::AVX2 == level) ops = &avx2::ops;
+#endif
+	_level.store(level, std::memory_order_relaxed);
+	_ops.store(ops, std::memory_order_release);
+}
+
+static inline const VecOps& ops(void)
+{
+	const VecOps* o = _ops.load(std::memory_order_acquire);
+	if (o) return *o;
+	set_simd_level(SimdLevel::AVX512);
+	return *_ops.load(std::memory_order_acquire);
+}
+
+SimdLevel opencog::simd_level(void)
+{
+	ops();
+	return _level.load(std::memory_order_relaxed);
+}
+
+const char* opencog::simd_level_name(SimdLevel level)
+{
+	if (SimdLevel::AVX512 == level) return "avx512";
+	if (SimdLevel::AVX2 == level) return "avx2";
+	return "scalar";
+}
+
+// ==============================================================
+
+void opencog::vec_add(double* out, const double* a, const double* b, size_t n)
+{
+	ops().add(out, a, b, n);
+}
+
+void opencog::vec_sub(double* out, const double* a, const double* b, size_t n)
+{
+	ops().sub(out, a, b, n);
+}
+
+void opencog::vec_mul(double* out, const double* a, const double* b, size_t n)
+{
+	ops().mul(out, a, b, n);
+}
+
+void opencog::vec_div(double* out, const double* a, const double* b, size_t n)
+{
+	ops().div(out, a, b, n);
+}
+
+void opencog::vec_add_scalar(double* out, double s, const double* a, size_t n)
+{
+	ops().add_s(out, s, a, n);
+}
+
+void opencog::vec_sub_scalar(double* out, double s, const double* a, size_t n)
+{
+	ops().sub_s(out, s, a, n);
+}
+
+void opencog::vec_mul_scalar(double* out, double s, const double* a, size_t n)
+{
+	ops().mul_s(out, s, a, n);
+}
+
+void opencog::vec_div_scalar(double* out, double s, const double* a, size_t n)
+{
+	ops().div_s(out, s, a, n);
+}
+
+void opencog::vec_sub_by(double* out, const double* a, double s, size_t n)
+{
+	ops().sub_by(out, a, s, n);
+}
+
+void opencog::vec_div_by(double* out, const double* a, double s, size_t n)
+{
+	ops().div_by(out, a, s, n);
+}
+
+void opencog::vec_mul_add(double* out, const double* a, const double* b,
+                          const double* c, size_t n)
+{
+	ops().mul_add(out, a, b, c, n);
+}
+
+void opencog::vec_scale_add(double* out, double s, const double* b,
+                            const double* c, size_t n)
+{
+	ops().scale_add(out, s, b, c, n);
+}
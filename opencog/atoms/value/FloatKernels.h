@@ -0,0 +1,94 @@
+/*
+ * opencog/atoms/value/FloatKernels.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FLOAT_KERNELS_H
+#define _OPENCOG_FLOAT_KERNELS_H
+
+#include <cstddef>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Point-wise arithmetic on arrays of doubles, for the FloatValue
+ * operators, and for the ArithmeticLinks working on them.
+ *
+ * There are AVX2 and AVX-512 versions, and a plain C++ version; the
+ * best one that the CPU can run is picked the first time any of them
+ * is called. All of them give bit-for-bit the same results: each
+ * element is rounded exactly as the plain loop would round it. In
+ * particular, vec_mul_add() does a multiply and then an add; it is
+ * fused in that it makes a single pass over memory, and not in the
+ * sense of a single rounding.
+ *
+ * Very long outputs are written with non-temporal (streaming) stores,
+ * so that they do not push the inputs out of the cache, and do not
+ * cost a read of the output before it is written.
+ *
+ * The output may be the same array as one of the inputs.
+ */
+
+/// out[i] = a[i] + b[i], and so on.
+void vec_add(double* out, const double* a, const double* b, size_t n);
+void vec_sub(double* out, const double* a, const double* b, size_t n);
+void vec_mul(double* out, const double* a, const double* b, size_t n);
+void vec_div(double* out, const double* a, const double* b, size_t n);
+
+/// out[i] = s + a[i], s - a[i], s * a[i] and s / a[i]
+void vec_add_scalar(double* out, double s, const double* a, size_t n);
+void vec_sub_scalar(double* out, double s, const double* a, size_t n);
+void vec_mul_scalar(double* out, double s, const double* a, size_t n);
+void vec_div_scalar(double* out, double s, const double* a, size_t n);
+
+/// out[i] = a[i] - s and a[i] / s
+void vec_sub_by(double* out, const double* a, double s, size_t n);
+void vec_div_by(double* out, const double* a, double s, size_t n);
+
+/// out[i] = a[i] * b[i] + c[i]
+void vec_mul_add(double* out, const double* a, const double* b,
+                 const double* c, size_t n);
+
+/// out[i] = s * b[i] + c[i]
+void vec_scale_add(double* out, double s, const double* b,
+                   const double* c, size_t n);
+
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+/// The best level that this CPU can run.
+SimdLevel simd_supported(void);
+
+/// The level in use.
+SimdLevel simd_level(void);
+const char* simd_level_name(SimdLevel);
+
+/// Use the given level, or the best one supported below it. This is
+/// for testing and benchmarking; it is not thread safe.
+void set_simd_level(SimdLevel);
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FLOAT_KERNELS_H
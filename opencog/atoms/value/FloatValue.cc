@@ -20,7 +20,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <opencog/util/exceptions.h>
+#include <opencog/atoms/value/FloatKernels.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
 
@@ -66,27 +69,43 @@ ValuePtr FloatValue::incrementCount(size_t idx, double count) const
 	return createFloatValue(_type, new_vect);
 }
 
-bool FloatValue::operator==(const Value& other) const
+/// Types that do not keep their numbers in _value.
+static bool elsewhere(Type t)
 {
-	// Unlike Atoms, we are willing to compare other types, as long
-	// as the type hierarchy makes sense, and the values compare.
-	if (not other.is_type(FLOAT_VALUE)) return false;
-
-   const FloatValue* fov = (const FloatValue*) &other;
+	return MAPPED_FLOAT_VALUE == t or FLOAT32_VALUE == t or
+		UINT32_VALUE == t or COUNTER_VALUE == t;
+}
 
-	if (_value.size() != fov->_value.size()) return false;
-	size_t len = _value.size();
+bool FloatValue::equal(const FloatSpan& a, const FloatSpan& b)
+{
+	if (a.size() != b.size()) return false;
+	size_t len = a.size();
 	for (size_t i=0; i<len; i++)
 		// Compare floats with ULPS, because they are lexicographically
 		// ordered. For technical explanation, see
 		// http://www.cygnus-software.com/papers/comparingfloats/Comparing%20floating%20point%20numbers.htm
-		// if (1.0e-15 < fabs(1.0 - fov->_value[i]/_value[i])) return false;
+		// if (1.0e-15 < fabs(1.0 - b[i]/a[i])) return false;
 #define MAX_ULPS 24
-		if (MAX_ULPS < llabs(*(int64_t*) &(_value[i]) - *(int64_t*)&(fov->_value[i])))
+		if (MAX_ULPS < llabs(*(int64_t*) &(a.data()[i]) - *(int64_t*)&(b.data()[i])))
 			return false;
 	return true;
 }
 
+bool FloatValue::operator==(const Value& other) const
+{
+	// Unlike Atoms, we are willing to compare other types, as long
+	// as the type hierarchy makes sense, and the values compare.
+	if (not other.is_type(FLOAT_VALUE)) return false;
+
+	// Mapped and compact values keep their numbers elsewhere; let
+	// them compare.
+	if (elsewhere(other.get_type()) and not elsewhere(_type))
+		return other == *this;
+
+   const FloatValue* fov = (const FloatValue*) &other;
+	return equal(_value, fov->_value);
+}
+
 // ==============================================================
 
 std::string FloatValue::to_string(const std::string& indent, Type t) const
@@ -109,63 +128,48 @@ std::string FloatValue::to_string(const std::string& indent, Type t) const
 // ==============================================================
 
 /// Scalar addition
-std::vector<double> opencog::plus(double scalar, const std::vector<double>& fv)
+std::vector<double> opencog::plus(double scalar, const FloatSpan& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> sum(len);
-	for (size_t i=0; i<len; i++)
-		sum[i] = scalar + fv[i];
-
+	std::vector<double> sum(fv.size());
+	vec_add_scalar(sum.data(), scalar, fv.data(), fv.size());
 	return sum;
 }
 
 /// Scalar subtraction
-std::vector<double> opencog::minus(double scalar, const std::vector<double>& fv)
+std::vector<double> opencog::minus(double scalar, const FloatSpan& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = scalar - fv[i];
-
+	std::vector<double> diff(fv.size());
+	vec_sub_scalar(diff.data(), scalar, fv.data(), fv.size());
 	return diff;
 }
 
-std::vector<double> opencog::minus(const std::vector<double>& fv, double scalar)
+std::vector<double> opencog::minus(const FloatSpan& fv, double scalar)
 {
-	size_t len = fv.size();
-	std::vector<double> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = fv[i] - scalar;
-
+	std::vector<double> diff(fv.size());
+	vec_sub_by(diff.data(), fv.data(), scalar, fv.size());
 	return diff;
 }
 
 /// Scalar multiplication
-std::vector<double> opencog::times(double scalar, const std::vector<double>& fv)
+std::vector<double> opencog::times(double scalar, const FloatSpan& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> prod(len);
-	for (size_t i=0; i<len; i++)
-		prod[i] = scalar * fv[i];
-
+	std::vector<double> prod(fv.size());
+	vec_mul_scalar(prod.data(), scalar, fv.data(), fv.size());
 	return prod;
 }
 
 /// Scalar division
-std::vector<double> opencog::divide(double scalar, const std::vector<double>& fv)
+std::vector<double> opencog::divide(double scalar, const FloatSpan& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> ratio(len);
-	for (size_t i=0; i<len; i++)
-		ratio[i] = scalar / fv[i];
-
+	std::vector<double> ratio(fv.size());
+	vec_div_scalar(ratio.data(), scalar, fv.data(), fv.size());
 	return ratio;
 }
 
 /// Vector (point-wise) addition
 /// The shorter vector is assumed to be zero-padded.
-std::vector<double> opencog::plus(const std::vector<double>& fva,
-                                  const std::vector<double>& fvb)
+std::vector<double> opencog::plus(const FloatSpan& fva,
+                                  const FloatSpan& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
@@ -179,27 +183,21 @@ std::vector<double> opencog::plus(const std::vector<double>& fva,
 	std::vector<double> sum(std::max(lena, lenb));
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lenb; i++)
-			sum[i] = fvb[i];
+		vec_add(sum.data(), fva.data(), fvb.data(), lena);
+		std::copy(fvb.begin() + lena, fvb.end(), sum.begin() + lena);
 	}
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lena; i++)
-			sum[i] = fva[i];
+		vec_add(sum.data(), fva.data(), fvb.data(), lenb);
+		std::copy(fva.begin() + lenb, fva.end(), sum.begin() + lenb);
 	}
 	return sum;
 }
 
 /// Vector (point-wise) subtraction
 /// The shorter vector is assumed to be zero-padded.
-std::vector<double> opencog::minus(const std::vector<double>& fva,
-                                   const std::vector<double>& fvb)
+std::vector<double> opencog::minus(const FloatSpan& fva,
+                                   const FloatSpan& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
@@ -213,19 +211,14 @@ std::vector<double> opencog::minus(const std::vector<double>& fva,
 	std::vector<double> diff(std::max(lena, lenb));
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lenb; i++)
+		vec_sub(diff.data(), fva.data(), fvb.data(), lena);
+		for (size_t i=lena; i<lenb; i++)
 			diff[i] = -fvb[i];
 	}
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lena; i++)
-			diff[i] = fva[i];
+		vec_sub(diff.data(), fva.data(), fvb.data(), lenb);
+		std::copy(fva.begin() + lenb, fva.end(), diff.begin() + lenb);
 	}
 	return diff;
 }
@@ -237,42 +230,28 @@ std::vector<double> opencog::minus(const std::vector<double>& fva,
 /// is the general user intent.  We could detect this case in all
 /// the callers to this routine, or we could just handle it here.
 /// This may seem messy to you, but this is the easiest solution.
-std::vector<double> opencog::times(const std::vector<double>& fva,
-                                   const std::vector<double>& fvb)
+std::vector<double> opencog::times(const FloatSpan& fva,
+                                   const FloatSpan& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
 
 	std::vector<double> prod(std::max(lena, lenb));
 	if (1 == lena)
-	{
-		double f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			prod[i] = f * fvb[i];
-	}
+		vec_mul_scalar(prod.data(), fva[0], fvb.data(), lenb);
 	else
 	if (1 == lenb)
-	{
-		double f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			prod[i] = f * fva[i];
-	}
+		vec_mul_scalar(prod.data(), fvb[0], fva.data(), lena);
 	else
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lenb; i++)
-			prod[i] = fvb[i];
+		vec_mul(prod.data(), fva.data(), fvb.data(), lena);
+		std::copy(fvb.begin() + lena, fvb.end(), prod.begin() + lena);
 	}
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lena; i++)
-			prod[i] = fva[i];
+		vec_mul(prod.data(), fva.data(), fvb.data(), lenb);
+		std::copy(fva.begin() + lenb, fva.end(), prod.begin() + lenb);
 	}
 	return prod;
 }
@@ -281,42 +260,29 @@ std::vector<double> opencog::times(const std::vector<double>& fva,
 /// The shorter vector is assumed to be one-padded.
 /// If the shorter vector has length one, assume its a scalar.
 /// See comments on times() above about scalars.
-std::vector<double> opencog::divide(const std::vector<double>& fva,
-                                    const std::vector<double>& fvb)
+std::vector<double> opencog::divide(const FloatSpan& fva,
+                                    const FloatSpan& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
 
 	std::vector<double> ratio(std::max(lena, lenb));
 	if (1 == lena)
-	{
-		double f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			ratio[i] = f / fvb[i];
-	}
+		vec_div_scalar(ratio.data(), fva[0], fvb.data(), lenb);
 	else
 	if (1 == lenb)
-	{
-		double f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			ratio[i] = fva[i] / f;
-	}
+		vec_div_by(ratio.data(), fva.data(), fvb[0], lena);
 	else
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lenb; i++)
-			ratio[i] = 1.0 / fvb[i];
+		vec_div(ratio.data(), fva.data(), fvb.data(), lena);
+		vec_div_scalar(ratio.data() + lena, 1.0, fvb.data() + lena,
+		               lenb - lena);
 	}
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lena; i++)
-			ratio[i] = fva[i];
+		vec_div(ratio.data(), fva.data(), fvb.data(), lenb);
+		std::copy(fva.begin() + lenb, fva.end(), ratio.begin() + lenb);
 	}
 	return ratio;
 }
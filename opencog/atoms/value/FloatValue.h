@@ -23,6 +23,7 @@
 #ifndef _OPENCOG_FLOAT_VALUE_H
 #define _OPENCOG_FLOAT_VALUE_H
 
+#include <memory>
 #include <vector>
 #include <opencog/atoms/value/Value.h>
 #include <opencog/atoms/atom_types/atom_types.h>
@@ -34,6 +35,35 @@ namespace opencog
  *  @{
  */
 
+/**
+ * A read-only view of an array of doubles that someone else owns:
+ * a FloatValue, a NumberNode, or a memory-mapped file. Numbers that
+ * are made on the fly, just to be looked at, are held by the span
+ * itself, and go away with the last copy of it.
+ */
+class FloatSpan
+{
+	const double* _data;
+	size_t _size;
+	std::shared_ptr<const std::vector<double>> _held;
+public:
+	FloatSpan(void) : _data(nullptr), _size(0) {}
+	FloatSpan(const double* d, size_t n) : _data(d), _size(n) {}
+	FloatSpan(const std::vector<double>& v) :
+		_data(v.data()), _size(v.size()) {}
+	explicit FloatSpan(std::vector<double>&& v) :
+		_held(std::make_shared<const std::vector<double>>(std::move(v)))
+	{ _data = _held->data(); _size = _held->size(); }
+
+	const double* data() const { return _data; }
+	size_t size() const { return _size; }
+	bool empty() const { return 0 == _size; }
+	const double* begin() const { return _data; }
+	const double* end() const { return _data + _size; }
+	double operator[](size_t i) const { return _data[i]; }
+	double back() const { return _data[_size-1]; }
+};
+
 /**
  * FloatValues hold an ordered vector of doubles.
  */
@@ -47,6 +77,9 @@ protected:
 
 	virtual void update() const {}
 
+	/// Equal to within a few ULPS, element by element.
+	static bool equal(const FloatSpan&, const FloatSpan&);
+
 	FloatValue(Type t) : Value(t) {}
 public:
 	FloatValue(Type t, const std::vector<double>& v) : Value(t), _value(v) {}
@@ -58,7 +91,19 @@ public:
 
 	virtual ~FloatValue() {}
 
-	const std::vector<double>& value() const { update(); return _value; }
+	/// A copy of the numbers. To look at them without copying them,
+	/// use span().
+	std::vector<double> value() const
+	{
+		FloatSpan nums(span());
+		return std::vector<double>(nums.begin(), nums.end());
+	}
+
+	/// The numbers, in place. Values that keep them in some other
+	/// form (the compact ones), or that change them in place (the
+	/// CounterValue), hand out a span over a temporary copy instead.
+	virtual FloatSpan span() const { update(); return _value; }
+
 	size_t size() const { return _value.size(); }
 	virtual ValuePtr value_at_index(size_t) const;
 	virtual ValuePtr incrementCount(const std::vector<double>&) const;
@@ -88,38 +133,38 @@ static inline std::shared_ptr<FloatValue> createFloatValue(Type&&... args) {
 }
 
 // Scalar multiplication and addition
-std::vector<double> plus(double, const std::vector<double>&);
-std::vector<double> minus(double, const std::vector<double>&);
-std::vector<double> minus(const std::vector<double>&, double);
-std::vector<double> times(double, const std::vector<double>&);
-std::vector<double> divide(double, const std::vector<double>&);
+std::vector<double> plus(double, const FloatSpan&);
+std::vector<double> minus(double, const FloatSpan&);
+std::vector<double> minus(const FloatSpan&, double);
+std::vector<double> times(double, const FloatSpan&);
+std::vector<double> divide(double, const FloatSpan&);
 
 inline
 ValuePtr plus(double f, const FloatValuePtr& fvp) {
-	return createFloatValue(plus(f, fvp->value()));
+	return createFloatValue(plus(f, fvp->span()));
 }
 inline
 ValuePtr minus(double f, const FloatValuePtr& fvp) {
-	return createFloatValue(minus(f, fvp->value()));
+	return createFloatValue(minus(f, fvp->span()));
 }
 inline
 ValuePtr minus(const FloatValuePtr& fvp, double f) {
-	return createFloatValue(minus(fvp->value(), f));
+	return createFloatValue(minus(fvp->span(), f));
 }
 inline
 ValuePtr times(double f, const FloatValuePtr& fvp) {
-	return createFloatValue(times(f, fvp->value()));
+	return createFloatValue(times(f, fvp->span()));
 }
 inline
 ValuePtr divide(double f, const FloatValuePtr& fvp) {
-	return createFloatValue(divide(f, fvp->value()));
+	return createFloatValue(divide(f, fvp->span()));
 }
 
 
-std::vector<double> plus(const std::vector<double>&, const std::vector<double>&);
-std::vector<double> minus(const std::vector<double>&, const std::vector<double>&);
-std::vector<double> times(const std::vector<double>&, const std::vector<double>&);
-std::vector<double> divide(const std::vector<double>&, const std::vector<double>&);
+std::vector<double> plus(const FloatSpan&, const FloatSpan&);
+std::vector<double> minus(const FloatSpan&, const FloatSpan&);
+std::vector<double> times(const FloatSpan&, const FloatSpan&);
+std::vector<double> divide(const FloatSpan&, const FloatSpan&);
 
 /// Vector multiplication and addition. When operating on an object
 /// times itself, take a sample first; this is needed to correctly
@@ -128,30 +173,30 @@ std::vector<double> divide(const std::vector<double>&, const std::vector<double>
 inline
 ValuePtr plus(const FloatValuePtr& fvpa, const FloatValuePtr& fvpb) {
 	if (fvpa != fvpb)
-		return createFloatValue(plus(fvpa->value(), fvpb->value()));
+		return createFloatValue(plus(fvpa->span(), fvpb->span()));
 	auto sample = fvpa->value();
-	return createFloatValue(plus(sample, fvpb->value()));
+	return createFloatValue(plus(sample, fvpb->span()));
 }
 inline
 ValuePtr minus(const FloatValuePtr& fvpa, const FloatValuePtr& fvpb) {
 	if (fvpa != fvpb)
-		return createFloatValue(minus(fvpa->value(), fvpb->value()));
+		return createFloatValue(minus(fvpa->span(), fvpb->span()));
 	auto sample = fvpa->value();
-	return createFloatValue(minus(sample, fvpb->value()));
+	return createFloatValue(minus(sample, fvpb->span()));
 }
 inline
 ValuePtr times(const FloatValuePtr& fvpa, const FloatValuePtr& fvpb) {
 	if (fvpa != fvpb)
-		return createFloatValue(times(fvpa->value(), fvpb->value()));
+		return createFloatValue(times(fvpa->span(), fvpb->span()));
 	auto sample = fvpa->value();
-	return createFloatValue(times(sample, fvpb->value()));
+	return createFloatValue(times(sample, fvpb->span()));
 }
 inline
 ValuePtr divide(const FloatValuePtr& fvpa, const FloatValuePtr& fvpb) {
 	if (fvpa != fvpb)
-		return createFloatValue(divide(fvpa->value(), fvpb->value()));
+		return createFloatValue(divide(fvpa->span(), fvpb->span()));
 	auto sample = fvpa->value();
-	return createFloatValue(divide(sample, fvpb->value()));
+	return createFloatValue(divide(sample, fvpb->span()));
 }
 
 /** @}*/
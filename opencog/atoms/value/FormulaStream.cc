@@ -21,6 +21,7 @@
  */
 
 #include <stdlib.h>
+#include <algorithm>
 #include <opencog/atoms/value/FormulaStream.h>
 #include <opencog/atoms/value/ValueFactory.h>
 #include <opencog/atoms/base/Atom.h>
@@ -97,8 +98,94 @@ void FormulaStream::init(void)
 
 // ==============================================================
 
-// XXX FIXME The update here is not thread-safe...
+/// Walk the formula, looking for the values it reads. ValueOfLinks
+/// and FloatValueOfLinks hand back the stream itself, so these are
+/// executed, to find it. The other kinds, such as StreamValueOfLink,
+/// sample the stream; they are not inputs.
+void FormulaStream::find_inputs(const Handle& h) const
+{
+	Type t = h->get_type();
+	if (VALUE_OF_LINK == t or FLOAT_VALUE_OF_LINK == t)
+	{
+		ValuePtr vp(h->execute(_as, true));
+		StreamValuePtr svp(StreamValueCast(vp));
+		if (svp and svp->is_chunked() and
+		    std::find(_inputs.begin(), _inputs.end(), svp) == _inputs.end())
+			_inputs.emplace_back(svp);
+		return;
+	}
+	if (not h->is_link()) return;
+	for (const Handle& ho : h->getOutgoingSet())
+		find_inputs(ho);
+}
+
+const std::vector<StreamValuePtr>& FormulaStream::inputs(void) const
+{
+	std::call_once(_found, [this]() {
+		if (1 != _formula.size() or not _formula[0]->is_executable())
+			return;
+		try { find_inputs(_formula[0]); }
+		catch (const SilentException&) { _inputs.clear(); }
+	});
+	return _inputs;
+}
+
+bool FormulaStream::is_chunked(void) const
+{
+	return not inputs().empty();
+}
+
+size_t FormulaStream::max_chunk(void) const
+{
+	size_t most = SIZE_MAX;
+	for (const StreamValuePtr& svp : inputs())
+		most = std::min(most, svp->max_chunk());
+	return most;
+}
+
+// ==============================================================
+
+/// The first stream sets the pace; the rest are read in lock-step,
+/// so that the formula sees samples that line up. Only the new
+/// chunk is computed on; nothing that was read before is kept.
+/// No more is read than every input can hold, so that a short read
+/// means that one of them has ended.
+FloatSpan FormulaStream::read_chunk(size_t max, size_t min)
+{
+	const std::vector<StreamValuePtr>& ins(inputs());
+	if (ins.empty())
+		return StreamValue::read_chunk(max, min);
+
+	max = std::min(max, max_chunk());
+	min = std::min(min, max);
+	size_t n = ins[0]->read_chunk(max, min).size();
+	for (size_t i = 1; i < ins.size() and 0 < n; i++)
+	{
+		size_t got = ins[i]->read_chunk(n, n).size();
+		if (got < n) n = 0;
+	}
+
+	// One of them has ended.
+	if (0 == n)
+	{
+		_value.clear();
+		return FloatSpan(_value);
+	}
+
+	compute();
+	return FloatSpan(_value);
+}
+
+// ==============================================================
+
+// A chunked stream is computed by read_chunk(), and not when sampled.
 void FormulaStream::update() const
+{
+	if (not is_chunked()) compute();
+}
+
+// XXX FIXME The update here is not thread-safe...
+void FormulaStream::compute() const
 {
 	if (1 == _formula.size())
 	{
@@ -23,6 +23,7 @@
 #ifndef _OPENCOG_FORMULA_STREAM_H
 #define _OPENCOG_FORMULA_STREAM_H
 
+#include <mutex>
 #include <vector>
 #include <opencog/atoms/value/StreamValue.h>
 #include <opencog/atoms/base/Handle.h>
@@ -38,6 +39,13 @@ namespace opencog
 /**
  * FormulaStream will evaluate the stored Atom to obtain a fresh
  * FloatValue, every time it is queried for data.
+ *
+ * If the formula reads (with ValueOfLink or FloatValueOfLink) from
+ * chunked streams, such as a BufferedStream, then it is chunked too:
+ * each read_chunk() pulls the next chunk from every one of those
+ * streams, in lock-step, and evaluates the formula over just that
+ * chunk. The current value() is then the result for the last chunk
+ * read, and is not computed again until the next read.
  */
 class FormulaStream
 	: public StreamValue
@@ -46,16 +54,27 @@ protected:
 	FormulaStream(Type t) : StreamValue(t) {}
 
 	void init(void);
+	void compute(void) const;
 	virtual void update() const;
 	HandleSeq _formula;
 	AtomSpace* _as;
 
+	// The chunked streams the formula reads from, found on first use.
+	mutable std::once_flag _found;
+	mutable std::vector<StreamValuePtr> _inputs;
+	void find_inputs(const Handle&) const;
+	const std::vector<StreamValuePtr>& inputs(void) const;
+
 public:
 	FormulaStream(const Handle&);
 	FormulaStream(const HandleSeq&&);
 	FormulaStream(const ValueSeq&);
 	virtual ~FormulaStream() {}
 
+	virtual FloatSpan read_chunk(size_t max, size_t min = 1);
+	virtual bool is_chunked(void) const;
+	virtual size_t max_chunk(void) const;
+
 	/** Returns a string representation of the value.  */
 	virtual std::string to_string(const std::string& indent = "") const;
 
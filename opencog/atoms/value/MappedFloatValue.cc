@@ -0,0 +1,217 @@
+/*
+ * opencog/atoms/value/MappedFloatValue.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/value/MappedFloatValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+MappedFloatValue::MappedFloatValue(std::shared_ptr<const void> owner,
+                                   const double* data, size_t len,
+                                   const std::string& path) :
+	FloatValue(MAPPED_FLOAT_VALUE),
+	_owner(std::move(owner)), _data(data), _len(len), _path(path)
+{}
+
+MappedFloatValue::MappedFloatValue(std::shared_ptr<const void> owner,
+                                   const double* data, size_t len) :
+	MappedFloatValue(std::move(owner), data, len, "")
+{}
+
+MappedFloatValue::MappedFloatValue(std::vector<double> v) :
+	FloatValue(MAPPED_FLOAT_VALUE), _path("")
+{
+	auto held = std::make_shared<const std::vector<double>>(std::move(v));
+	_data = held->data();
+	_len = held->size();
+	_owner = held;
+}
+
+MappedFloatValue::MappedFloatValue(const std::string& path,
+                                   size_t first, size_t count) :
+	FloatValue(MAPPED_FLOAT_VALUE), _data(nullptr), _len(0), _path(path)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open %s: %s", path.c_str(), strerror(errno));
+
+	struct stat st;
+	if (fstat(fd, &st))
+	{
+		int err = errno;
+		close(fd);
+		throw RuntimeException(TRACE_INFO,
+			"Cannot stat %s: %s", path.c_str(), strerror(err));
+	}
+
+	size_t total = st.st_size / sizeof(double);
+	if (total < first)
+	{
+		close(fd);
+		throw RuntimeException(TRACE_INFO,
+			"%s holds %zu numbers; cannot start at %zu",
+			path.c_str(), total, first);
+	}
+	_len = std::min(count, total - first);
+
+	// Nothing to map; mmap() refuses a length of zero.
+	if (0 == _len)
+	{
+		close(fd);
+		return;
+	}
+
+	// The offset handed to mmap() must be a multiple of the page size.
+	size_t offset = first * sizeof(double);
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t start = offset - offset % page;
+	size_t maplen = offset - start + _len * sizeof(double);
+
+	void* base = mmap(nullptr, maplen, PROT_READ, MAP_SHARED, fd, start);
+	int err = errno;
+	close(fd);
+	if (MAP_FAILED == base)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot map %s: %s", path.c_str(), strerror(err));
+
+	_owner = std::shared_ptr<const void>(base,
+		[maplen](const void* p) { munmap((void*) p, maplen); });
+	_data = (const double*) ((const char*) base + (offset - start));
+}
+
+// ==============================================================
+
+ValuePtr MappedFloatValue::slice(size_t first, size_t count) const
+{
+	if (_len < first)
+		throw RuntimeException(TRACE_INFO,
+			"Slice starts at %zu, past the end at %zu", first, _len);
+	count = std::min(count, _len - first);
+	return std::shared_ptr<MappedFloatValue>(
+		new MappedFloatValue(_owner, _data + first, count, _path));
+}
+
+// ==============================================================
+
+ValuePtr MappedFloatValue::value_at_index(size_t idx) const
+{
+	double d = 0.0;
+	if (_len > idx) d = _data[idx];
+	return createFloatValue(d);
+}
+
+ValuePtr MappedFloatValue::incrementCount(const std::vector<double>& v) const
+{
+	std::vector<double> new_vect(_data, _data + _len);
+	if (new_vect.size() < v.size())
+		new_vect.resize(v.size(), 0.0);
+
+	for (size_t idx=0; idx < v.size(); idx++)
+		new_vect[idx] += v[idx];
+
+	// The file is read-only; the sum is held privately.
+	return createMappedFloatValue(std::move(new_vect));
+}
+
+ValuePtr MappedFloatValue::incrementCount(size_t idx, double count) const
+{
+	std::vector<double> new_vect(_data, _data + _len);
+	if (new_vect.size() <= idx)
+		new_vect.resize(idx+1, 0.0);
+
+	new_vect[idx] += count;
+	return createMappedFloatValue(std::move(new_vect));
+}
+
+// ==============================================================
+
+bool MappedFloatValue::operator==(const Value& other) const
+{
+	if (this == &other) return true;
+	if (not other.is_type(FLOAT_VALUE)) return false;
+
+	FloatSpan mine(span());
+	FloatSpan theirs(((const FloatValue&) other).span());
+	if (mine.size() != theirs.size()) return false;
+
+	// Within a few ULPS, as in FloatValue::operator==()
+	for (size_t i=0; i<mine.size(); i++)
+	{
+		int64_t a, b;
+		memcpy(&a, mine.data() + i, sizeof(a));
+		memcpy(&b, theirs.data() + i, sizeof(b));
+		if (24 < llabs(a - b)) return false;
+	}
+	return true;
+}
+
+/// The numbers, printed straight from the mapping, without the copy
+/// that FloatValue::to_string() would make.
+std::string MappedFloatValue::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	for (size_t i=0; i<_len; i++)
+	{
+		char buf[40];
+		snprintf(buf, 40, "%.16g", _data[i]);
+		rv += std::string(" ") + buf;
+	}
+	rv += ")";
+	return rv;
+}
+
+// ==============================================================
+
+void MappedFloatValue::write_file(const std::string& path,
+                                  const FloatSpan& nums)
+{
+	FILE* fh = fopen(path.c_str(), "wb");
+	if (nullptr == fh)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot create %s: %s", path.c_str(), strerror(errno));
+
+	size_t wrote = fwrite(nums.data(), sizeof(double), nums.size(), fh);
+	int err = errno;
+	if (fclose(fh) or wrote != nums.size())
+		throw RuntimeException(TRACE_INFO,
+			"Cannot write %s: %s", path.c_str(), strerror(err));
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_VALUE_FACTORY(MAPPED_FLOAT_VALUE,
+                     createMappedFloatValue, std::vector<double>)
+DEFINE_VALUE_FACTORY(MAPPED_FLOAT_VALUE,
+                     createMappedFloatValue, std::string)
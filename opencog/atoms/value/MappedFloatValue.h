@@ -0,0 +1,123 @@
+/*
+ * opencog/atoms/value/MappedFloatValue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_MAPPED_FLOAT_VALUE_H
+#define _OPENCOG_MAPPED_FLOAT_VALUE_H
+
+#include <memory>
+#include <string>
+
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * MappedFloatValues are FloatValues whose numbers live in a file that
+ * is mapped into memory, or in some other buffer that is not theirs,
+ * rather than in a vector of their own.
+ *
+ * The file holds nothing but the doubles, in native byte order, as
+ * written by write_file() (or by numpy's `tofile()`). It is mapped
+ * read-only and shared, so that it may be larger than RAM (the kernel
+ * pages it in as it is read), and so that several processes mapping
+ * the same file (e.g. one in /dev/shm) share one copy of it.
+ *
+ * slice() makes another MappedFloatValue over part of the same
+ * mapping, without copying anything. The mapping is released when
+ * the last slice of it goes away.
+ *
+ * span() gives the numbers in place; the arithmetic on FloatValues,
+ * the ArithmeticLinks and the columns use it, and never copy the
+ * numbers. The inherited value() copies them into a new vector, each
+ * time it is called.
+ */
+class MappedFloatValue
+	: public FloatValue
+{
+protected:
+	// Whatever keeps the numbers alive: the mapping, or the buffer.
+	std::shared_ptr<const void> _owner;
+	const double* _data;
+	size_t _len;
+	std::string _path;
+
+	MappedFloatValue(std::shared_ptr<const void>, const double*, size_t,
+	                 const std::string&);
+
+public:
+	/// Map `count` doubles of the file at `path`, starting with the
+	/// double at index `first`. By default, all of them.
+	MappedFloatValue(const std::string& path,
+	                 size_t first = 0, size_t count = SIZE_MAX);
+
+	/// Numbers held elsewhere; `owner` keeps them alive, for as long
+	/// as this value, or any slice of it, exists.
+	MappedFloatValue(std::shared_ptr<const void> owner,
+	                 const double* data, size_t len);
+
+	/// The numbers in `v`, held privately; nothing is mapped. This is
+	/// for the factory, and thus for the sexpr reader.
+	MappedFloatValue(std::vector<double> v);
+
+	virtual ~MappedFloatValue() {}
+
+	virtual FloatSpan span() const { return FloatSpan(_data, _len); }
+	virtual size_t size() const { return _len; }
+
+	/// The file that is mapped, or the empty string.
+	const std::string& path() const { return _path; }
+
+	/// `count` numbers, starting at `first`, sharing this mapping.
+	ValuePtr slice(size_t first, size_t count) const;
+
+	virtual ValuePtr value_at_index(size_t) const;
+	virtual ValuePtr incrementCount(const std::vector<double>&) const;
+	virtual ValuePtr incrementCount(size_t, double) const;
+
+	virtual std::string to_string(const std::string& indent = "") const;
+
+	/** Returns true if two values are equal. */
+	virtual bool operator==(const Value&) const;
+
+	/// Write `nums` to the file at `path`, in the form that the
+	/// constructor maps.
+	static void write_file(const std::string& path, const FloatSpan& nums);
+};
+
+typedef std::shared_ptr<const MappedFloatValue> MappedFloatValuePtr;
+static inline MappedFloatValuePtr MappedFloatValueCast(const ValuePtr& a)
+	{ return std::dynamic_pointer_cast<const MappedFloatValue>(a); }
+
+template<typename ... Type>
+static inline std::shared_ptr<MappedFloatValue> createMappedFloatValue(Type&&... args) {
+	return std::make_shared<MappedFloatValue>(std::forward<Type>(args)...);
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_MAPPED_FLOAT_VALUE_H
@@ -20,20 +20,30 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <thread>
+
+#include <opencog/util/exceptions.h>
 #include <opencog/atoms/value/QueueValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
 
 using namespace opencog;
 
-typedef concurrent_queue<ValuePtr> conq;
-
 // ==============================================================
 
+QueueValue::QueueValue(Type t)
+	: ContainerValue(t),
+	_nspill(0), _closed(false), _adding(0), _waiting(0)
+{}
+
+QueueValue::QueueValue(void)
+	: QueueValue(QUEUE_VALUE)
+{}
+
 QueueValue::QueueValue(const ValueSeq& vseq)
-	: ContainerValue(QUEUE_VALUE)
+	: QueueValue(QUEUE_VALUE)
 {
 	for (const ValuePtr& v: vseq)
-		push(v); // concurrent_queue<ValuePtr>::push(v);
+		add(v);
 
 	// Since this constructor placed stuff on the queue,
 	// we also close it, to indicate we are "done" placing
@@ -44,6 +54,95 @@ QueueValue::QueueValue(const ValueSeq& vseq)
 
 // ==============================================================
 
+void QueueValue::push(ValuePtr&& vp)
+{
+	// Counted, so that close() can wait for the adds under way.
+	_adding++;
+	if (_closed)
+	{
+		_adding--;
+		throw RuntimeException(TRACE_INFO,
+			"Cannot add to a closed QueueValue");
+	}
+
+	// Once anything has spilled, everything does, until the readers
+	// have caught up; otherwise, later values could jump ahead.
+	if (0 < _nspill or not _ring.try_push(std::move(vp)))
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_spill.emplace_back(std::move(vp));
+		_nspill++;
+	}
+	_adding--;
+
+	// The fence pairs with the one in take(): either the reader sees
+	// the value, or we see the reader.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (0 < _waiting)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_cv.notify_one();
+	}
+}
+
+/// The ring holds the oldest values; the spill, the newer ones.
+bool QueueValue::try_take(ValuePtr& vp)
+{
+	if (_ring.try_pop(vp)) return true;
+	if (0 == _nspill) return false;
+
+	// Only once the ring is really empty. It may have looked empty
+	// because an add was still filling in its cell, or it may have
+	// been added to since. Checked under the lock, so that anything
+	// that went into the ring before a spilled value was added is
+	// seen here.
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (not _ring.empty() or _spill.empty()) return false;
+	vp = std::move(_spill.front());
+	_spill.pop_front();
+	_nspill--;
+	return true;
+}
+
+/// Wait for a value. Returns false if the queue is closed, and there
+/// is nothing left in it.
+bool QueueValue::take(ValuePtr& vp)
+{
+	while (true)
+	{
+		if (try_take(vp)) return true;
+		if (_closed)
+		{
+			while (0 < _adding) std::this_thread::yield();
+			while (0 < pending())
+				if (try_take(vp)) return true;
+			return false;
+		}
+
+		// A writer may be just about done; give it a chance, before
+		// going to sleep.
+		for (int i = 0; i < 8; i++)
+		{
+			std::this_thread::yield();
+			if (try_take(vp)) return true;
+		}
+
+		std::unique_lock<std::mutex> lck(_mtx);
+		_waiting++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		_cv.wait(lck, [this]() {
+			return _closed or not _ring.empty() or not _spill.empty(); });
+		_waiting--;
+	}
+}
+
+size_t QueueValue::pending(void) const
+{
+	return _ring.size() + _nspill;
+}
+
+// ==============================================================
+
 // This will clear the return value, and then block until the
 // writer closes the queue. Only then does this return. Upon
 // return, all of the values that the writer ever wrote are
@@ -53,85 +152,75 @@ QueueValue::QueueValue(const ValueSeq& vseq)
 // produce a bunch of values, and, when done, close the queue. The
 // reader can then hoover them all up by calling LinkValue::value()
 //
-// Alternately, more clever users can work with the concurrent queue
-// API directly; they do not need to go through this API.
+// Alternately, more clever users can work with add() and remove()
+// directly; they do not need to go through this API.
 void QueueValue::update() const
 {
 	// Do nothing; we don't want to clobber the _value
-	if (is_closed() and 0 == conq::size()) return;
+	if (is_closed() and 0 == pending()) return;
 
 	// Reset, to start with.
 	_value.clear();
 
-	// Loop forever, as long as the queue is open.
-	try
-	{
-		while (true)
-		{
-			ValuePtr val;
-			const_cast<QueueValue*>(this) -> pop(val);
-			_value.emplace_back(val);
-		}
-	}
-	catch (typename conq::Canceled& e)
-	{}
-
-	// If we are here, the queue closed up. Reopen it
-	// just long enough to drain any remaining values.
-	const_cast<QueueValue*>(this) -> cancel_reset();
-	while (not is_empty())
-	{
-		ValuePtr val;
-		const_cast<QueueValue*>(this) -> pop(val);
-		_value.emplace_back(val);
-	}
-	const_cast<QueueValue*>(this) -> cancel();
+	// Loop forever, as long as the queue is open, and then
+	// drain whatever remains.
+	ValuePtr val;
+	while (const_cast<QueueValue*>(this) -> take(val))
+		_value.emplace_back(std::move(val));
 }
 
 // ==============================================================
 
 void QueueValue::open()
 {
-	if (not conq::is_closed()) return;
-	conq::open();
+	_closed = false;
 }
 
 void QueueValue::close()
 {
-	if (conq::is_closed()) return;
-	conq::close();
+	if (_closed.exchange(true)) return;
+
+	// Let the adds already under way finish, and then wake
+	// everyone who is waiting, so that they see the close.
+	while (0 < _adding) std::this_thread::yield();
+	std::lock_guard<std::mutex> lck(_mtx);
+	_cv.notify_all();
 }
 
 bool QueueValue::is_closed() const
 {
-	return conq::is_closed();
+	return _closed;
 }
 
 // ==============================================================
 
 void QueueValue::add(const ValuePtr& vp)
 {
-	conq::push(vp);
+	push(ValuePtr(vp));
 }
 
 void QueueValue::add(ValuePtr&& vp)
 {
-	conq::push(vp);
+	push(std::move(vp));
 }
 
 ValuePtr QueueValue::remove(void)
 {
-	return conq::value_pop();
+	ValuePtr vp;
+	if (_closed or not take(vp))
+		throw RuntimeException(TRACE_INFO,
+			"Cannot remove from a closed QueueValue");
+	return vp;
 }
 
 size_t QueueValue::size(void) const
 {
 	if (is_closed())
 	{
-		if (0 != conq::size()) update();
+		if (0 != pending()) update();
 		return _value.size();
 	}
-	return conq::size();
+	return pending();
 }
 
 // ==============================================================
@@ -141,16 +230,8 @@ void QueueValue::clear()
 	// Reset contents
 	_value.clear();
 
-	// Do nothing; we don't want to clobber the _value
-	if (conq::is_closed())
-	{
-		conq::wait_and_take_all();
-		return;
-	}
-
-	conq::close();
-	conq::wait_and_take_all();
-	conq::open();
+	ValuePtr val;
+	while (try_take(val)) {}
 }
 
 // ==============================================================
@@ -23,8 +23,13 @@
 #ifndef _OPENCOG_QUEUE_VALUE_H
 #define _OPENCOG_QUEUE_VALUE_H
 
-#include <opencog/util/concurrent_queue.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include <opencog/atoms/value/ContainerValue.h>
+#include <opencog/atoms/value/RingQueue.h>
 #include <opencog/atoms/atom_types/atom_types.h>
 
 namespace opencog
@@ -38,16 +43,42 @@ namespace opencog
  * QueueValues provide a thread-safe FIFO queue of Values. They are
  * meant to be used for producer-consumer APIs, where the produced
  * values are to be handled in sequential order, in a different thread.
+ *
+ * Values are passed through a lock-free ring (a RingQueue), so that
+ * many threads can add at once (e.g. the pattern matcher, reporting
+ * groundings) without fighting over a lock. If the ring fills up, the
+ * overflow goes to a plain, locked deque, until the ring has been
+ * emptied out; thus, the queue is never full, and adding never blocks.
+ * Values added by any one thread come out in the order added. Readers
+ * that find the queue empty wait on a condition variable, which the
+ * writers only touch when someone is waiting.
  */
 class QueueValue
-	: public ContainerValue, protected concurrent_queue<ValuePtr>
+	: public ContainerValue
 {
 protected:
-	QueueValue(Type t) : ContainerValue(t) {}
+	QueueValue(Type t);
 	virtual void update() const;
 
+	RingQueue<ValuePtr> _ring;
+
+	// Overflow, for when the ring is full, and sleeping readers.
+	mutable std::mutex _mtx;
+	std::condition_variable _cv;
+	std::deque<ValuePtr> _spill;
+	std::atomic<size_t> _nspill;
+
+	std::atomic<bool> _closed;
+	std::atomic<int> _adding;
+	std::atomic<int> _waiting;
+
+	void push(ValuePtr&&);
+	bool try_take(ValuePtr&);
+	bool take(ValuePtr&);
+	size_t pending(void) const;
+
 public:
-	QueueValue(void) : ContainerValue(QUEUE_VALUE) {}
+	QueueValue(void);
 	QueueValue(const ValueSeq&);
 	virtual ~QueueValue() {}
 	virtual void open(void);
@@ -0,0 +1,143 @@
+/*
+ * opencog/atoms/value/RingQueue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_RING_QUEUE_H
+#define _OPENCOG_RING_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A bounded, lock-free queue, for many producers and many consumers.
+ * Neither try_push() nor try_pop() ever waits: they fail instead, when
+ * the queue is full, or empty. Waiting, if wanted, is up to the user.
+ *
+ * This is Dmitry Vyukov's bounded MPMC queue. Each cell carries a
+ * sequence number, which says whose turn it is: a producer may fill
+ * cell i when its number is i, and a consumer may empty it when its
+ * number is i+1. Producers and consumers each race for their end with
+ * a single compare-and-swap, and then work on their own cell, without
+ * getting in each other's way.
+ */
+template<typename T>
+class RingQueue
+{
+	struct Cell
+	{
+		std::atomic<size_t> seq;
+		T data;
+	};
+
+	// The two ends are on their own cache lines, so that producers
+	// do not slow down consumers, and the other way around.
+	alignas(64) std::atomic<size_t> _enq;
+	alignas(64) std::atomic<size_t> _deq;
+	alignas(64) std::unique_ptr<Cell[]> _cells;
+	size_t _mask;
+
+	/// Claim the cell at the end that `at` counts, once its sequence
+	/// number is `pos + lag`. Returns null if it is not yet its turn.
+	Cell* claim(std::atomic<size_t>& at, size_t lag, size_t& pos)
+	{
+		pos = at.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell* c = &_cells[pos & _mask];
+			size_t seq = c->seq.load(std::memory_order_acquire);
+			intptr_t dif = (intptr_t) seq - (intptr_t) (pos + lag);
+			if (0 == dif)
+			{
+				if (at.compare_exchange_weak(pos, pos + 1,
+				                             std::memory_order_relaxed))
+					return c;
+			}
+			else if (dif < 0)
+				return nullptr;
+			else
+				pos = at.load(std::memory_order_relaxed);
+		}
+	}
+
+public:
+	/// The capacity is rounded up to a power of two.
+	RingQueue(size_t capacity = 1024) : _enq(0), _deq(0)
+	{
+		size_t n = 2;
+		while (n < capacity) n <<= 1;
+		_mask = n - 1;
+		_cells.reset(new Cell[n]);
+		for (size_t i = 0; i < n; i++)
+			_cells[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	RingQueue(const RingQueue&) = delete;
+	RingQueue& operator=(const RingQueue&) = delete;
+
+	size_t capacity(void) const { return _mask + 1; }
+
+	/// Returns false, and leaves `v` alone, if the queue is full.
+	template<typename U>
+	bool try_push(U&& v)
+	{
+		size_t pos;
+		Cell* c = claim(_enq, 0, pos);
+		if (nullptr == c) return false;
+		c->data = std::forward<U>(v);
+		c->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Returns false if the queue is empty.
+	bool try_pop(T& v)
+	{
+		size_t pos;
+		Cell* c = claim(_deq, 1, pos);
+		if (nullptr == c) return false;
+		v = std::move(c->data);
+		c->data = T();
+		c->seq.store(pos + _mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Only a snapshot; it may be out of date as soon as it is taken.
+	size_t size(void) const
+	{
+		size_t deq = _deq.load(std::memory_order_acquire);
+		size_t enq = _enq.load(std::memory_order_acquire);
+		return (enq > deq) ? enq - deq : 0;
+	}
+
+	bool empty(void) const { return 0 == size(); }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_RING_QUEUE_H
@@ -0,0 +1,151 @@
+/*
+ * opencog/atoms/value/ShardedSet.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SHARDED_SET_H
+#define _OPENCOG_SHARDED_SET_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A thread-safe hash set, split into shards, each with its own lock.
+ * An element goes to the shard picked by its hash, so that threads
+ * inserting different elements seldom wait for one another; only
+ * those inserting into the same shard at the same moment do.
+ *
+ * Elements are taken out in no particular order. They are copied
+ * out, and not moved: erasing from an unordered_set may need the hash
+ * of the element, and a moved-from element no longer has the same one.
+ */
+template<typename T, typename Hash = std::hash<T>,
+         typename Equal = std::equal_to<T>>
+class ShardedSet
+{
+	// Each on its own cache line, so that the locks do not share.
+	struct alignas(64) Shard
+	{
+		std::mutex mtx;
+		std::unordered_set<T, Hash, Equal> set;
+	};
+
+	std::vector<Shard> _shards;
+	std::atomic<size_t> _size;
+	std::atomic<size_t> _next;
+	Hash _hash;
+
+	// The low bits of a hash often go into the buckets of the
+	// unordered_set; use the high bits to pick the shard.
+	Shard& shard(const T& v)
+	{
+		size_t h = _hash(v) * 0x9E3779B97F4A7C15ULL;
+		return _shards[(h >> 40) % _shards.size()];
+	}
+
+public:
+	ShardedSet(size_t nshards = 64) :
+		_shards(nshards), _size(0), _next(0)
+	{}
+
+	ShardedSet(const ShardedSet&) = delete;
+	ShardedSet& operator=(const ShardedSet&) = delete;
+
+	/// Returns false if it was already there.
+	template<typename U>
+	bool insert(U&& v)
+	{
+		Shard& s = shard(v);
+		std::lock_guard<std::mutex> lck(s.mtx);
+		if (not s.set.insert(std::forward<U>(v)).second) return false;
+		_size++;
+		return true;
+	}
+
+	bool contains(const T& v)
+	{
+		Shard& s = shard(v);
+		std::lock_guard<std::mutex> lck(s.mtx);
+		return s.set.find(v) != s.set.end();
+	}
+
+	/// Returns false if it was not there.
+	bool erase(const T& v)
+	{
+		Shard& s = shard(v);
+		std::lock_guard<std::mutex> lck(s.mtx);
+		if (0 == s.set.erase(v)) return false;
+		_size--;
+		return true;
+	}
+
+	/// Take out some element. Returns false if there were none.
+	/// Successive calls start at successive shards, so that several
+	/// takers spread out, instead of all going to the first shard.
+	bool try_take(T& v)
+	{
+		if (0 == _size) return false;
+		size_t n = _shards.size();
+		size_t start = _next++;
+		for (size_t i = 0; i < n; i++)
+		{
+			Shard& s = _shards[(start + i) % n];
+			std::lock_guard<std::mutex> lck(s.mtx);
+			if (s.set.empty()) continue;
+			auto it = s.set.begin();
+			v = *it;
+			s.set.erase(it);
+			_size--;
+			return true;
+		}
+		return false;
+	}
+
+	/// Append everything to `out`, leaving the set empty.
+	template<typename Seq>
+	void take_all(Seq& out)
+	{
+		for (Shard& s : _shards)
+		{
+			std::lock_guard<std::mutex> lck(s.mtx);
+			out.insert(out.end(), s.set.begin(), s.set.end());
+			_size -= s.set.size();
+			s.set.clear();
+		}
+	}
+
+	/// Only a snapshot; it may be out of date as soon as it is taken.
+	size_t size(void) const { return _size; }
+	bool empty(void) const { return 0 == _size; }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_SHARDED_SET_H
@@ -27,6 +27,14 @@ using namespace opencog;
 
 // ==============================================================
 
+FloatSpan StreamValue::read_chunk(size_t max, size_t min)
+{
+	update();
+	return FloatSpan(_value);
+}
+
+// ==============================================================
+
 bool StreamValue::operator==(const Value& other) const
 {
 	// Since we're streaming, get the latest value before comparing!
@@ -23,6 +23,8 @@
 #ifndef _OPENCOG_STREAM_VALUE_H
 #define _OPENCOG_STREAM_VALUE_H
 
+#include <cstdint>
+
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/atom_types/atom_types.h>
 
@@ -41,7 +43,10 @@ namespace opencog
  * audio feeds, or other kinds of high-bandwidth data.
  *
  * This class itself doesn't "do anything" other than to provide
- * a base class.
+ * a base class, and the read_chunk() protocol, for getting samples
+ * in batches. Streams that only sample (e.g. RandomStream) give a
+ * fresh sample for every read; buffered streams (e.g. BufferedStream)
+ * give each sample exactly once, in order.
  *
  * See also LinkStreamValue when the data is encoded as Atoms or
  * as other (non-floating-point) Values.
@@ -56,6 +61,25 @@ protected:
 public:
 	virtual ~StreamValue() {}
 
+	/**
+	 * Pull up to `max` samples that have not been read before, waiting
+	 * until there are at least `min` of them, or the stream has ended.
+	 * The samples become the current value(); the span is good until
+	 * the next read or update. An empty span means the stream ended.
+	 *
+	 * By default, this is a single fresh sample of the whole vector,
+	 * whatever its size.
+	 */
+	virtual FloatSpan read_chunk(size_t max, size_t min = 1);
+
+	/// True if read_chunk() gives each sample once, in order, instead
+	/// of sampling.
+	virtual bool is_chunked(void) const { return false; }
+
+	/// The most samples that one read_chunk() can wait for; a `min`
+	/// larger than this is lowered to it.
+	virtual size_t max_chunk(void) const { return SIZE_MAX; }
+
 	/** Returns true if two atoms are equal.  */
 	virtual bool operator==(const Value&) const;
 };
@@ -0,0 +1,139 @@
+/*
+ * opencog/atoms/value/UInt32Value.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/value/UInt32Value.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+using namespace opencog;
+
+// ==============================================================
+
+UInt32Value::UInt32Value(const std::vector<uint32_t>& v) :
+	FloatValue(UINT32_VALUE), _u32(v)
+{}
+
+UInt32Value::UInt32Value(std::vector<uint32_t>&& v) :
+	FloatValue(UINT32_VALUE), _u32(std::move(v))
+{}
+
+UInt32Value::UInt32Value(uint32_t v) :
+	FloatValue(UINT32_VALUE), _u32(1, v)
+{}
+
+UInt32Value::UInt32Value(const std::vector<double>& v) :
+	FloatValue(UINT32_VALUE)
+{
+	_u32.reserve(v.size());
+	for (double d : v)
+	{
+		if (not (0.0 <= d and d <= UINT32_MAX) or d != floor(d))
+			throw RuntimeException(TRACE_INFO,
+				"UInt32Value cannot hold %.16g", d);
+		_u32.push_back(d);
+	}
+}
+
+/// The numbers, widened, in a copy held by the span; for code that
+/// works on FloatValues. The arithmetic links use _u32 directly.
+FloatSpan UInt32Value::span() const
+{
+	return FloatSpan(std::vector<double>(_u32.begin(), _u32.end()));
+}
+
+// ==============================================================
+
+ValuePtr UInt32Value::value_at_index(size_t idx) const
+{
+	uint32_t u = 0;
+	if (_u32.size() > idx) u = _u32[idx];
+	return createUInt32Value(u);
+}
+
+/// Counts incremented by counts stay counts; anything else, such as a
+/// fractional or a negative increment, gives a FloatValue.
+static ValuePtr counts_or_floats(std::vector<double>&& sum)
+{
+	for (double d : sum)
+		if (not (0.0 <= d and d <= UINT32_MAX) or d != floor(d))
+			return createFloatValue(std::move(sum));
+	return createUInt32Value(sum);
+}
+
+ValuePtr UInt32Value::incrementCount(const std::vector<double>& v) const
+{
+	std::vector<double> new_vect(_u32.begin(), _u32.end());
+	if (new_vect.size() < v.size())
+		new_vect.resize(v.size(), 0.0);
+
+	for (size_t idx=0; idx < v.size(); idx++)
+		new_vect[idx] += v[idx];
+
+	return counts_or_floats(std::move(new_vect));
+}
+
+ValuePtr UInt32Value::incrementCount(size_t idx, double count) const
+{
+	std::vector<double> new_vect(_u32.begin(), _u32.end());
+	if (new_vect.size() <= idx)
+		new_vect.resize(idx+1, 0.0);
+
+	new_vect[idx] += count;
+	return counts_or_floats(std::move(new_vect));
+}
+
+// ==============================================================
+
+bool UInt32Value::operator==(const Value& other) const
+{
+	if (this == &other) return true;
+	if (not other.is_type(FLOAT_VALUE)) return false;
+
+	if (UINT32_VALUE == other.get_type())
+		return _u32 == ((const UInt32Value&) other)._u32;
+
+	// Counts are exact; so must the other numbers be.
+	FloatSpan theirs(((const FloatValue&) other).span());
+	if (_u32.size() != theirs.size()) return false;
+	for (size_t i=0; i<_u32.size(); i++)
+		if (_u32[i] != theirs[i]) return false;
+	return true;
+}
+
+std::string UInt32Value::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	for (uint32_t u : _u32)
+		rv += " " + std::to_string(u);
+	rv += ")";
+	return rv;
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_VALUE_FACTORY(UINT32_VALUE,
+                     createUInt32Value, std::vector<double>)
+DEFINE_VALUE_FACTORY(UINT32_VALUE,
+                     createUInt32Value, std::vector<uint32_t>)
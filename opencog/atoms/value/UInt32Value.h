@@ -0,0 +1,92 @@
+/*
+ * opencog/atoms/value/UInt32Value.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_UINT32_VALUE_H
+#define _OPENCOG_UINT32_VALUE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * UInt32Values hold an ordered vector of unsigned 32-bit integers;
+ * counts, mostly. Half the size of a FloatValue, and exact.
+ *
+ * The arithmetic links work on them directly; see CompactArith.h for
+ * what type the result has. A sum or a product that does not fit in
+ * 32 bits gives a FloatValue, not a wrapped-around count. Code written
+ * for FloatValues also works, through value() and span(): these widen
+ * the numbers to doubles, in a temporary copy, every time they are
+ * asked for; nothing is kept.
+ */
+class UInt32Value
+	: public FloatValue
+{
+protected:
+	std::vector<uint32_t> _u32;
+
+public:
+	UInt32Value(const std::vector<uint32_t>& v);
+	UInt32Value(std::vector<uint32_t>&& v);
+	UInt32Value(uint32_t v);
+
+	/// The numbers must be whole, and between zero and 2^32-1. For
+	/// the factory, and thus for the sexpr reader.
+	UInt32Value(const std::vector<double>& v);
+
+	virtual ~UInt32Value() {}
+
+	const std::vector<uint32_t>& value32() const { return _u32; }
+	virtual FloatSpan span() const;
+	virtual size_t size() const { return _u32.size(); }
+
+	virtual ValuePtr value_at_index(size_t) const;
+	virtual ValuePtr incrementCount(const std::vector<double>&) const;
+	virtual ValuePtr incrementCount(size_t, double) const;
+
+	virtual std::string to_string(const std::string& indent = "") const;
+
+	/** Returns true if two values are equal. */
+	virtual bool operator==(const Value&) const;
+};
+
+typedef std::shared_ptr<const UInt32Value> UInt32ValuePtr;
+static inline UInt32ValuePtr UInt32ValueCast(const ValuePtr& a)
+	{ return std::dynamic_pointer_cast<const UInt32Value>(a); }
+
+template<typename ... Type>
+static inline std::shared_ptr<UInt32Value> createUInt32Value(Type&&... args) {
+	return std::make_shared<UInt32Value>(std::forward<Type>(args)...);
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_UINT32_VALUE_H
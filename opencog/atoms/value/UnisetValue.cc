@@ -20,20 +20,36 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <thread>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/value/UnisetValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
 
 using namespace opencog;
 
-typedef concurrent_set<ValuePtr> conset;
-
 // ==============================================================
 
+size_t UnisetValue::ValueHash::operator()(const ValuePtr& vp) const
+{
+	if (vp->is_atom()) return ((const Atom*) vp.get())->get_hash();
+	return std::hash<const Value*>()(vp.get());
+}
+
+UnisetValue::UnisetValue(Type t)
+	: ContainerValue(t), _closed(false), _adding(0), _waiting(0)
+{}
+
+UnisetValue::UnisetValue(void)
+	: UnisetValue(UNISET_VALUE)
+{}
+
 UnisetValue::UnisetValue(const ValueSeq& vseq)
-	: ContainerValue(UNISET_VALUE)
+	: UnisetValue(UNISET_VALUE)
 {
 	for (const ValuePtr& v: vseq)
-		conset::insert(v);
+		add(v);
 
 	// Since this constructor placed stuff on the queue,
 	// we also close it, to indicate we are "done" placing
@@ -44,6 +60,53 @@ UnisetValue::UnisetValue(const ValueSeq& vseq)
 
 // ==============================================================
 
+void UnisetValue::insert(ValuePtr&& vp)
+{
+	// Counted, so that close() can wait for the adds under way.
+	_adding++;
+	if (_closed)
+	{
+		_adding--;
+		throw RuntimeException(TRACE_INFO,
+			"Cannot add to a closed UnisetValue");
+	}
+	bool added = _set.insert(std::move(vp));
+	_adding--;
+	if (not added) return;
+
+	// The fence pairs with the one in take(): either the reader sees
+	// the value, or we see the reader.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (0 < _waiting)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_cv.notify_one();
+	}
+}
+
+/// Wait for a value. Returns false if the set is closed, and there
+/// is nothing left in it.
+bool UnisetValue::take(ValuePtr& vp)
+{
+	while (true)
+	{
+		if (_set.try_take(vp)) return true;
+		if (_closed)
+		{
+			while (0 < _adding) std::this_thread::yield();
+			return _set.try_take(vp);
+		}
+
+		std::unique_lock<std::mutex> lck(_mtx);
+		_waiting++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		_cv.wait(lck, [this]() { return _closed or not _set.empty(); });
+		_waiting--;
+	}
+}
+
+// ==============================================================
+
 // This will clear the return value, and then block until the
 // writer closes the queue. Only then does this return. Upon
 // return, all of the values that the writer ever wrote are
@@ -53,85 +116,84 @@ UnisetValue::UnisetValue(const ValueSeq& vseq)
 // produce a bunch of values, and, when done, close the queue. The
 // reader can then hoover them all up by calling LinkValue::value()
 //
-// Alternately, more clever users can work with the concurrent queue
-// API directly; they do not need to go through this API.
+// Alternately, more clever users can work with add() and remove()
+// directly; they do not need to go through this API.
 void UnisetValue::update() const
 {
 	// Do nothing; we don't want to clobber the _value
-	if (is_closed() and 0 == conset::size()) return;
+	if (is_closed() and _set.empty()) return;
 
 	// Reset, to start with.
 	_value.clear();
 
-	// Loop forever, as long as the queue is open.
-	try
-	{
-		while (true)
-		{
-			ValuePtr val;
-			const_cast<UnisetValue*>(this) -> get(val);
-			_value.emplace_back(val);
-		}
-	}
-	catch (typename conset::Canceled& e)
-	{}
+	// Loop forever, as long as the set is open.
+	UnisetValue* self = const_cast<UnisetValue*>(this);
+	ValuePtr val;
+	while (not _closed and self->take(val))
+		_value.emplace_back(std::move(val));
 
-	// If we are here, the queue closed up. Reopen it
-	// just long enough to drain any remaining values.
-	const_cast<UnisetValue*>(this) -> cancel_reset();
-	while (not is_empty())
-	{
-		ValuePtr val;
-		const_cast<UnisetValue*>(this) -> get(val);
-		_value.emplace_back(val);
-	}
-	const_cast<UnisetValue*>(this) -> cancel();
+	// If we are here, the set closed up. Drain the rest in one go.
+	while (0 < _adding) std::this_thread::yield();
+	self->_set.take_all(_value);
 }
 
 // ==============================================================
 
 void UnisetValue::open()
 {
-	if (not is_closed()) return;
-	conset::open();
+	_closed = false;
 }
 
 void UnisetValue::close()
 {
-	if (is_closed()) return;
-	conset::close();
+	if (_closed.exchange(true)) return;
+
+	// Let the adds already under way finish, and then wake
+	// everyone who is waiting, so that they see the close.
+	while (0 < _adding) std::this_thread::yield();
+	std::lock_guard<std::mutex> lck(_mtx);
+	_cv.notify_all();
 }
 
 bool UnisetValue::is_closed() const
 {
-	return conset::is_closed();
+	return _closed;
 }
 
 // ==============================================================
 
 void UnisetValue::add(const ValuePtr& vp)
 {
-	conset::insert(vp);
+	insert(ValuePtr(vp));
 }
 
 void UnisetValue::add(ValuePtr&& vp)
 {
-	conset::insert(vp);
+	insert(std::move(vp));
 }
 
 ValuePtr UnisetValue::remove(void)
 {
-	return conset::value_get();
+	ValuePtr vp;
+	if (_closed or not take(vp))
+		throw RuntimeException(TRACE_INFO,
+			"Cannot remove from a closed UnisetValue");
+	return vp;
+}
+
+bool UnisetValue::erase(const ValuePtr& vp)
+{
+	return _set.erase(vp);
 }
 
 size_t UnisetValue::size(void) const
 {
 	if (is_closed())
 	{
-		if (0 != conset::size()) update();
+		if (not _set.empty()) update();
 		return _value.size();
 	}
-	return conset::size();
+	return _set.size();
 }
 
 // ==============================================================
@@ -141,16 +203,8 @@ void UnisetValue::clear()
 	// Reset contents
 	_value.clear();
 
-	// Do nothing; we don't want to clobber the _value
-	if (conset::is_closed())
-	{
-		conset::wait_and_take_all();
-		return;
-	}
-
-	conset::close();
-	conset::wait_and_take_all();
-	conset::open();
+	ValueSeq gone;
+	_set.take_all(gone);
 }
 
 // ==============================================================
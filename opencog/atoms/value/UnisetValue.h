@@ -23,8 +23,12 @@
 #ifndef _OPENCOG_UNISET_VALUE_H
 #define _OPENCOG_UNISET_VALUE_H
 
-#include <opencog/util/concurrent_set.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include <opencog/atoms/value/ContainerValue.h>
+#include <opencog/atoms/value/ShardedSet.h>
 #include <opencog/atoms/atom_types/atom_types.h>
 
 namespace opencog
@@ -40,16 +44,40 @@ namespace opencog
  * values are added, possibly in different threads from which they
  * are removed.  This is a uniset, in that elements are deduplicated
  * so that the set contains only one copy of a given element.
+ *
+ * The elements are kept in a ShardedSet, so that many threads (e.g.
+ * a parallel pattern search, reporting groundings) can add at once,
+ * each locking only the shard its value hashes to. Atoms are sharded
+ * by their content hash; other Values by address. Either way, two
+ * elements are the same if they are the same object, which, for
+ * Atoms, is the same as having the same content.
  */
 class UnisetValue
-	: public ContainerValue, protected concurrent_set<ValuePtr>
+	: public ContainerValue
 {
 protected:
-	UnisetValue(Type t) : ContainerValue(t) {}
+	UnisetValue(Type t);
 	virtual void update() const;
 
+	struct ValueHash
+	{
+		size_t operator()(const ValuePtr&) const;
+	};
+	ShardedSet<ValuePtr, ValueHash> _set;
+
+	// For readers waiting on an empty set.
+	mutable std::mutex _mtx;
+	std::condition_variable _cv;
+
+	std::atomic<bool> _closed;
+	std::atomic<int> _adding;
+	std::atomic<int> _waiting;
+
+	void insert(ValuePtr&&);
+	bool take(ValuePtr&);
+
 public:
-	UnisetValue(void) : ContainerValue(UNISET_VALUE) {}
+	UnisetValue(void);
 	UnisetValue(const ValueSeq&);
 	virtual ~UnisetValue() {}
 	virtual void open(void);
@@ -60,6 +88,12 @@ public:
 	virtual void add(ValuePtr&&);
 	virtual ValuePtr remove(void);
 	virtual size_t size(void) const;
+
+	/// Take out this particular value, if it is there, and has not
+	/// been removed yet. Returns false if it was not there. For
+	/// producers that take back what they added; see StandingQuery.
+	bool erase(const ValuePtr&);
+
 	virtual void clear(void);
 
 	virtual bool operator==(const Value&) const;
@@ -319,16 +319,22 @@ bool AtomSpace::in_environ(const AtomSpace* as) const
 {
     if (nullptr == as) return false;
     if (as == this) return true;
-    const std::vector<AtomSpacePtr>* env = &_environ;
-    while (true)
+
+    // Go down the stack, taking the skips that do not go past the
+    // depth of `as`; all the frames in between are deeper than it.
+    // Once under that depth, it is not in this stack, so skip to
+    // the bottom.
+    const AtomSpace* eas = this;
+    while (0 < eas->_depth)
     {
-        size_t evs = env->size();
-        if (0 == evs) return false;
-        if (1 < evs) break;
-        if (as == (*env)[0].get()) return true;
-        env = &((*env)[0]->_environ);
+        if (use_frame_filters and (eas->_depth < as->_depth or
+            as->_depth <= eas->_skip->_depth))
+            eas = eas->_skip;
+        else
+            eas = eas->_environ[0].get();
+        if (as == eas) return true;
     }
-    for (const AtomSpacePtr& base : *env)
+    for (const AtomSpacePtr& base : eas->_environ)
     {
         if (base->in_environ(as)) return true;
     }
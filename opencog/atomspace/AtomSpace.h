@@ -25,6 +25,9 @@
 #ifndef _OPENCOG_ATOMSPACE_H
 #define _OPENCOG_ATOMSPACE_H
 
+#include <functional>
+#include <mutex>
+
 #include <opencog/util/async_method_caller.h>
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_omp.h>
@@ -35,7 +38,10 @@
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 
+#include <opencog/atomspace/AtomWatcher.h>
 #include <opencog/atomspace/Frame.h>
+#include <opencog/atomspace/GroundingMemo.h>
+#include <opencog/atomspace/RuleIndex.h>
 #include <opencog/atomspace/TypeIndex.h>
 
 class AtomTableUTest;
@@ -57,6 +63,7 @@ typedef std::shared_ptr<AtomSpace> AtomSpacePtr;
 class AtomSpace : public Frame
 {
     friend class StorageNode;     // Needs to call add() directly.
+    friend class BulkLoader;      // Needs typeIndex and add().
 
     // Debug tools
     static const bool EMIT_DIAGNOSTICS = true;
@@ -94,6 +101,41 @@ class AtomSpace : public Frame
     int addedTypeConnection;
     void typeAdded(Type);
 
+    /** Clause groundings, kept from one search to the next. */
+    GroundingMemo _memo;
+
+    /**
+     * Told of each Atom added or extracted; see add_watcher(). The
+     * list is never changed in place: a new one is published, so that
+     * notifying takes no lock. The mutex serializes the publishers.
+     */
+    typedef std::vector<std::weak_ptr<AtomWatcher>> WatcherList;
+    std::mutex _watch_mtx;
+    std::shared_ptr<const WatcherList> _watchers;
+    std::atomic<bool> _watched;
+    void notify_added(const Handle&);
+    void notify_added(const HandleSeq&);
+    void notify_extracted(const Handle&);
+    void notify_cleared(void);
+
+    /** The rules in this space, for the Recognizer; made on demand. */
+    std::mutex _rule_mtx;
+    RuleIndexPtr _rule_index;
+
+    /**
+     * Skip pointers, for deep stacks of Frames. The depth is the number
+     * of frames under this one, down to the first that has no base, or
+     * more than one, or is transient; `_skip` is one of those frames,
+     * further down. The `_block` filter covers this frame, and all of
+     * the ones above the skip. Transient spaces have none of these.
+     * See link_frames().
+     */
+    size_t _depth;
+    AtomSpace* _skip;
+    std::unique_ptr<AtomFilter> _block;
+    void link_frames(void);
+    void unlink_frames(void);
+
     void init();
     void clear_all_atoms();
 
@@ -198,6 +240,13 @@ public:
     bool in_environ(const Handle&) const;
     bool in_environ(const AtomSpace*) const;
 
+    /**
+     * Lookups skip over the frames that cannot hold the Atom, by way
+     * of the filters kept for each frame. If set to false, every frame
+     * is searched in turn. Meant for benchmarking.
+     */
+    static bool use_frame_filters;
+
     /* AtomSpaces are Atoms; provide virtual methods of base class. */
     virtual const std::string& get_name() const;
     virtual Arity get_arity() const { return _environ.size(); }
@@ -238,6 +287,48 @@ public:
     size_t get_size() const;
     size_t get_num_atoms_of_type(Type type, bool subclass=false) const;
 
+    /**
+     * Return the number of atoms of the given type and arity, summed
+     * over this space and all the spaces under it. Arities of seven
+     * or more are all counted together. This is an estimate, meant
+     * for query planning: it takes no locks, and, in a stack of
+     * frames, atoms that are shadowed or hidden are counted anyway.
+     */
+    size_t get_num_atoms_of_arity(Type type, Arity arity) const;
+
+    /**
+     * Return a number that changes whenever an atom of the given type
+     * is added to, or removed from this space, or any of the spaces
+     * under it. Anything computed from the atoms of that type is still
+     * good, if this has not changed.
+     */
+    size_t get_type_stamp(Type type) const;
+
+    /**
+     * The memo of clause groundings, used by the pattern matcher to
+     * carry groundings over from one search to the next.
+     */
+    GroundingMemo& get_grounding_memo(void) { return _memo; }
+
+    /**
+     * Tell the watcher about each Atom that is added to, or extracted
+     * from this AtomSpace, from here on; see AtomWatcher. Only a weak
+     * pointer is kept: the watcher stops hearing about changes when it
+     * is destroyed, or when it is removed. add_atoms() reports the
+     * Atoms that it made after each level of the batch is in.
+     */
+    void add_watcher(const AtomWatcherPtr&);
+    void remove_watcher(const AtomWatcher*);
+
+    /**
+     * The index of the rules (the Links with variables or globs in
+     * them) in this AtomSpace, used by the Recognizer (the DualLink).
+     * It is made the first time that it is asked for, and it is kept
+     * up to date from then on. Returns nullptr if this AtomSpace has
+     * bases: the index would not see the changes made to them.
+     */
+    RuleIndexPtr get_rule_index(void);
+
     //! Clear the atomspace, extract all atoms.
     void clear();
 
@@ -338,6 +429,25 @@ public:
 	    return add_link(t, {ha, hb, hc, hd, he, hf, hg, hh, hi});
     }
 
+    /**
+     * Add a batch of Atoms to the AtomSpace. Returns the Atoms, in the
+     * same order, as they are in this AtomSpace; this is the same as
+     * calling add_atom() on each, but much faster for large batches.
+     *
+     * The batch is added in chunks of a few thousand Atoms, and each
+     * chunk one level at a time: first all of the Nodes, then all of
+     * the Links holding only Nodes, and so on. Each level is
+     * deduplicated in parallel, the incoming-set updates are grouped
+     * by target Atom, and the type index is grown and locked once per
+     * stripe, instead of once per Atom. Other threads may use the
+     * AtomSpace while the load is in progress.
+     *
+     * Frames (Atomspaces with parents), and batches containing Atoms
+     * with special insertion semantics (e.g. StateLink, DefineLink,
+     * DeleteLink) fall back to one-at-a-time adds, for those Atoms.
+     */
+    HandleSeq add_atoms(HandleSeq&&);
+
     /**
      * Given a Value, find all of the Atoms inside of it, and add them
      * to the AtomSpace. Return an equivalent Value, with all Atoms
@@ -492,6 +602,34 @@ public:
                         bool parent=true,
                         const AtomSpace* = nullptr) const;
 
+    /**
+     * Call `fn` on each Atom of the given type (and subclasses,
+     * optionally), one at a time, without first copying them all
+     * into a HandleSeq. Use this to scan types that hold many
+     * millions of Atoms.
+     *
+     * The walk does not block other threads that add or remove
+     * Atoms. Atoms that are added or removed while the walk is in
+     * progress might or might not be visited; all other Atoms are
+     * visited exactly once (per frame, if `parent` is set). The
+     * callback may itself add or remove Atoms.
+     *
+     * Copy-on-write spaces, and the StateLink, DefineLink and
+     * TypedAtomLink types, have to be resolved against the other
+     * frames, and are copied first, as in get_handles_by_type().
+     *
+     * Example:
+     * @code
+     *         size_t cnt = 0;
+     *         as->for_each_by_type(CONCEPT_NODE,
+     *             [&](const Handle& h) { cnt++; });
+     * @endcode
+     */
+    void for_each_by_type(Type type,
+                          const std::function<void(const Handle&)>& fn,
+                          bool subclass=false,
+                          bool parent=true) const;
+
     /**
      * Gets a set of handles that matches with the given type,
      * but ONLY if they have an empty incoming set! 
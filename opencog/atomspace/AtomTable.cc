@@ -53,6 +53,14 @@ void AtomSpace::init(void)
     _uuid = _id_pool.fetch_add(1, std::memory_order_relaxed);
 
     _name = "(uuid . " + std::to_string(_uuid) + ")";
+    _watched = false;
+    _depth = 0;
+    _skip = nullptr;
+
+    // Only frames get skipped over; see lookupHide(). Transient spaces
+    // are not worth it; see ready_transient().
+    if (not _transient and not _environ.empty())
+        typeIndex.use_filter();
 
     // Connect signal to find out about type additions
     addedTypeConnection =
@@ -69,7 +77,8 @@ AtomSpace::AtomSpace(AtomSpace* parent, bool transient) :
     _read_only(false),
     _copy_on_write(transient),
     _transient(transient),
-    _nameserver(nameserver())
+    _nameserver(nameserver()),
+    _memo(this)
 {
     if (parent) {
         // Set the COW flag by default, for any Atomspace that sits on
@@ -80,6 +89,10 @@ AtomSpace::AtomSpace(AtomSpace* parent, bool transient) :
         _outgoing.push_back(HandleCast(parent));
     }
     init();
+
+    // Transient spaces are made and thrown away far too often for
+    // the skips to pay off; see ready_transient().
+    if (not _transient) link_frames();
 }
 
 AtomSpace::AtomSpace(AtomSpacePtr& parent) :
@@ -87,7 +100,8 @@ AtomSpace::AtomSpace(AtomSpacePtr& parent) :
     _read_only(false),
     _copy_on_write(false),
     _transient(false),
-    _nameserver(nameserver())
+    _nameserver(nameserver()),
+    _memo(this)
 {
     if (nullptr != parent) {
         // Set the COW flag by default; it seems like a simpler
@@ -98,6 +112,7 @@ AtomSpace::AtomSpace(AtomSpacePtr& parent) :
     }
 
     init();
+    link_frames();
 }
 
 AtomSpace::AtomSpace(const HandleSeq& bases) :
@@ -105,7 +120,8 @@ AtomSpace::AtomSpace(const HandleSeq& bases) :
     _read_only(false),
     _copy_on_write(false),
     _transient(false),
-    _nameserver(nameserver())
+    _nameserver(nameserver()),
+    _memo(this)
 {
     for (const Handle& base : bases)
     {
@@ -117,11 +133,13 @@ AtomSpace::AtomSpace(const HandleSeq& bases) :
 
     if (0 < bases.size()) _copy_on_write = true;
     init();
+    link_frames();
 }
 
 
 AtomSpace::~AtomSpace()
 {
+    unlink_frames();
     _nameserver.typeAddedSignal().disconnect(addedTypeConnection);
     clear_all_atoms();
 }
@@ -134,7 +152,10 @@ void AtomSpace::ready_transient(AtomSpace* parent)
         throw RuntimeException(TRACE_INFO,
                 "AtomSpace - ready called on non-transient atom table.");
 
-    // Set the new parent environment and holder atomspace.
+    // Set the new parent environment and holder atomspace. There are
+    // no skips to set up: the transient is searched on its own, and
+    // then its parent, with the parent's skips. A frame put on top of
+    // the transient starts counting its depth over again.
     _environ.push_back(AtomSpaceCast(parent));
     _outgoing.push_back(HandleCast(parent));
 }
@@ -153,14 +174,90 @@ void AtomSpace::clear_transient()
     _outgoing.clear();
 }
 
+// ====================================================================
+
+bool AtomSpace::use_frame_filters = true;
+
+// The most frames that a skip can jump over.
+#define MAX_SKIP 1024
+
+/// Set up the skip pointer, and the block filter. The frames in a
+/// stack are split up into blocks, in the same way as a Fenwick tree:
+/// the frame at depth d covers the lowbit(d) frames from d down, and
+/// skips to the one under those. So a frame at depth 12 covers the
+/// frames at 12 through 9 and skips to 8, which covers 8 through 1,
+/// and skips to the bottom. Any run of frames can be gotten past in
+/// a logarithmic number of skips. Each frame is in about as many
+/// blocks as there are bits in MAX_SKIP.
+///
+/// The block filter is sized to the Atoms already in the frames that
+/// it covers; Atoms added to them later are noted in it as well (see
+/// TypeIndex::cover()) so that it does not go stale; but it may get
+/// full, if many are.
+void AtomSpace::link_frames(void)
+{
+    unlink_frames();
+    if (1 != _environ.size()) return;
+
+    AtomSpace* base = _environ[0].get();
+    _depth = base->_depth + 1;
+    size_t span = std::min<size_t>(_depth & (~_depth + 1), MAX_SKIP);
+
+    std::vector<AtomSpace*> covered({this});
+    AtomSpace* as = base;
+    for (size_t i = 1; i < span; i++)
+    {
+        covered.push_back(as);
+        as = as->_environ[0].get();
+    }
+    _skip = as;
+    if (1 == span) return;
+
+    size_t natoms = 0;
+    for (AtomSpace* cas : covered)
+        natoms += cas->typeIndex.size();
+    size_t nbits = 1024;
+    while (nbits < 16 * natoms and nbits < (1UL << 24))
+        nbits *= 2;
+
+    // Watch first, and then look, so that nothing is missed.
+    _block.reset(new AtomFilter(nbits));
+    for (AtomSpace* cas : covered)
+        cas->typeIndex.cover(_block.get());
+    for (AtomSpace* cas : covered)
+        cas->typeIndex.for_each(ATOM, true,
+            [&](const Handle& h) { _block->insert(h); });
+}
+
+void AtomSpace::unlink_frames(void)
+{
+    if (_block)
+    {
+        for (AtomSpace* as = this; as != _skip; as = as->_environ[0].get())
+            as->typeIndex.uncover(_block.get());
+        _block.reset();
+    }
+    _depth = 0;
+    _skip = nullptr;
+
+    // Only frames get skipped over; see lookupHide(). Transient spaces
+    // are not worth it; see ready_transient().
+    if (not _transient and not _environ.empty())
+        typeIndex.use_filter();
+}
+
+// ====================================================================
+
 void AtomSpace::clear_all_atoms()
 {
     typeIndex.clear();
+    _memo.clear();
 }
 
 void AtomSpace::clear()
 {
     clear_all_atoms();
+    notify_cleared();
 }
 
 /// Find an equivalent atom that is exactly the same as the arg. If
@@ -189,13 +286,25 @@ Handle AtomSpace::lookupHide(const Handle& a, bool hide) const
     size_t esz = _environ.size();
     if (0 == esz) return Handle::UNDEFINED;
 
-    AtomSpacePtr eas = _environ[0];
+    // Frames that cannot hold the Atom are skipped, a block at
+    // a time, if possible; see link_frames().
+    const AtomSpace* eas = _environ[0].get();
     while (1 == esz)
     {
-        const Handle& h(eas->typeIndex.findAtom(a));
-        if (h) {
-            if (hide and h->isAbsent()) return Handle::UNDEFINED;
-            return h;
+        if (use_frame_filters and eas->_block and
+            not eas->_block->may_contain(a))
+        {
+            eas = eas->_skip;
+            continue;
+        }
+
+        if (not use_frame_filters or eas->typeIndex.may_contain(a))
+        {
+            const Handle& h(eas->typeIndex.findAtom(a));
+            if (h) {
+                if (hide and h->isAbsent()) return Handle::UNDEFINED;
+                return h;
+            }
         }
 
         esz = eas->_environ.size();
@@ -213,7 +322,7 @@ Handle AtomSpace::lookupHide(const Handle& a, bool hide) const
              return Handle::UNDEFINED;
         }
 
-        eas = eas->_environ[0];
+        eas = eas->_environ[0].get();
     }
 
     // In the case of multiple inheritance, check each merge, until
@@ -250,6 +359,8 @@ Handle AtomSpace::check(const Handle& orig, bool force)
         if (hc->isAbsent()) {
             if (_read_only) return Handle::UNDEFINED;
             hc->setPresent();
+            typeIndex.touch(hc);
+            notify_added(hc);
         }
         return hc;
     }
@@ -408,6 +519,9 @@ Handle AtomSpace::add(const Handle& orig, bool force,
         atom->remove();
         return oldh;
     }
+
+    // Atoms that hide others are reported when they are hidden.
+    if (not absent) notify_added(atom);
     return atom;
 }
 
@@ -438,6 +552,106 @@ size_t AtomSpace::get_num_atoms_of_type(Type type, bool subclass) const
     return result;
 }
 
+size_t AtomSpace::get_num_atoms_of_arity(Type type, Arity arity) const
+{
+    size_t result = typeIndex.size_by_arity(type, arity);
+
+    for (const AtomSpacePtr& base : _environ)
+        result += base->get_num_atoms_of_arity(type, arity);
+
+    return result;
+}
+
+size_t AtomSpace::get_type_stamp(Type type) const
+{
+    size_t stamp = typeIndex.stamp(type);
+
+    for (const AtomSpacePtr& base : _environ)
+        stamp += base->get_type_stamp(type);
+
+    return stamp;
+}
+
+// ====================================================================
+
+void AtomSpace::add_watcher(const AtomWatcherPtr& w)
+{
+    std::lock_guard<std::mutex> lck(_watch_mtx);
+    std::shared_ptr<WatcherList> ws(std::make_shared<WatcherList>());
+    std::shared_ptr<const WatcherList> old(std::atomic_load(&_watchers));
+    if (old) *ws = *old;
+    ws->push_back(w);
+    std::atomic_store(&_watchers, std::shared_ptr<const WatcherList>(ws));
+    _watched = true;
+}
+
+/// Also forgets the watchers that are gone.
+void AtomSpace::remove_watcher(const AtomWatcher* w)
+{
+    std::lock_guard<std::mutex> lck(_watch_mtx);
+    std::shared_ptr<WatcherList> keep(std::make_shared<WatcherList>());
+    std::shared_ptr<const WatcherList> old(std::atomic_load(&_watchers));
+    if (old)
+    {
+        for (const std::weak_ptr<AtomWatcher>& wp : *old)
+        {
+            AtomWatcherPtr sp(wp.lock());
+            if (sp and sp.get() != w) keep->push_back(wp);
+        }
+    }
+    _watched = not keep->empty();
+    std::atomic_store(&_watchers, std::shared_ptr<const WatcherList>(keep));
+}
+
+// The watchers are called without holding any lock; they may well
+// add more Atoms, or add more watchers. Those added meanwhile hear
+// about the next change, and not this one.
+#define FOR_EACH_WATCHER(DO_THIS)                                 \
+    if (not _watched) return;                                     \
+    std::shared_ptr<const WatcherList> ws(                        \
+        std::atomic_load(&_watchers));                            \
+    if (nullptr == ws) return;                                    \
+    for (const std::weak_ptr<AtomWatcher>& wp : *ws)              \
+    {                                                             \
+        AtomWatcherPtr w(wp.lock());                              \
+        if (w) w->DO_THIS;                                        \
+    }
+
+void AtomSpace::notify_added(const Handle& h)
+{
+    FOR_EACH_WATCHER(atom_added(h))
+}
+
+void AtomSpace::notify_added(const HandleSeq& hs)
+{
+    FOR_EACH_WATCHER(atoms_added(hs))
+}
+
+void AtomSpace::notify_extracted(const Handle& h)
+{
+    FOR_EACH_WATCHER(atom_extracted(h))
+}
+
+void AtomSpace::notify_cleared(void)
+{
+    FOR_EACH_WATCHER(atoms_cleared())
+}
+
+RuleIndexPtr AtomSpace::get_rule_index(void)
+{
+    if (0 < _environ.size()) return nullptr;
+
+    std::lock_guard<std::mutex> lck(_rule_mtx);
+    if (nullptr == _rule_index)
+    {
+        _rule_index = std::make_shared<RuleIndex>(this);
+        _rule_index->fill(_rule_index);
+    }
+    return _rule_index;
+}
+
+// ====================================================================
+
 bool AtomSpace::extract_atom(const Handle& h, bool recursive)
 {
     if (nullptr == h) return false;
@@ -497,6 +711,8 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
         // If we are here, then mask.
         const Handle& hide(add(handle, true, true, true));
         hide->setAbsent();
+        typeIndex.touch(hide);
+        notify_extracted(handle);
         return true;
     }
 
@@ -518,6 +734,8 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
         if (_copy_on_write) {
             const Handle& hide(add(handle, true, true, true));
             hide->setAbsent();
+            typeIndex.touch(hide);
+            notify_extracted(handle);
             return true;
         }
 
@@ -536,6 +754,8 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
             {
                 const Handle& hide(add(handle, true, true, true));
                 hide->setAbsent();
+                typeIndex.touch(hide);
+                notify_extracted(handle);
                 return true;
             }
         }
@@ -571,6 +791,7 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
     // Remove handle from other incoming sets.
     handle->remove();
     handle->setAtomSpace(nullptr);
+    notify_extracted(handle);
 
     return true;
 }
@@ -728,6 +949,32 @@ void AtomSpace::get_handles_by_type(UnorderedHandleSet& hset,
     shadow_by_type(hset, type, subclass, parent, cas);
 }
 
+void AtomSpace::for_each_by_type(Type type,
+                                 const std::function<void(const Handle&)>& fn,
+                                 bool subclass,
+                                 bool parent) const
+{
+    // Copy-on-write spaces must hide Atoms in deeper frames, and
+    // the unique-link types resolve to the shallowest definition.
+    // Both need the whole set in hand; do it the old way.
+    if (_copy_on_write or STATE_LINK == type or
+        DEFINE_LINK == type or TYPED_ATOM_LINK == type)
+    {
+        HandleSeq hseq;
+        get_handles_by_type(hseq, type, subclass, parent);
+        for (const Handle& h : hseq)
+            fn(h);
+        return;
+    }
+
+    typeIndex.for_each(type, subclass, fn);
+
+    if (parent) {
+        for (const AtomSpacePtr& base : _environ)
+            base->for_each_by_type(type, fn, subclass, parent);
+    }
+}
+
 /**
  * Returns the set of atoms of a given type, but only if they have
  * and empty outgoing set.
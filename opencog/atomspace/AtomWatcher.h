@@ -0,0 +1,77 @@
+/*
+ * opencog/atomspace/AtomWatcher.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ATOM_WATCHER_H
+#define _OPENCOG_ATOM_WATCHER_H
+
+#include <memory>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Something that wants to hear about each Atom that is added to, or
+ * extracted from an AtomSpace, as it happens. See
+ * AtomSpace::add_watcher().
+ *
+ * The methods are called on the thread that made the change, after
+ * the change is visible, and with no AtomSpace locks held; so they
+ * may look at, and change, the AtomSpace. When a Link is added, its
+ * outgoing set is reported first; when an Atom is extracted
+ * recursively, its incoming set is reported first. Only the changes
+ * made in the AtomSpace being watched are reported, and not those in
+ * the AtomSpaces underneath it.
+ */
+class AtomWatcher
+{
+public:
+	virtual ~AtomWatcher() {}
+
+	/// The Atom was added, or un-hidden.
+	virtual void atom_added(const Handle&) = 0;
+
+	/// A batch of Atoms was added by AtomSpace::add_atoms(), each one
+	/// after its outgoing set. By default, they are passed on to
+	/// atom_added(), one at a time.
+	virtual void atoms_added(const HandleSeq& hs)
+	{
+		for (const Handle& h : hs) atom_added(h);
+	}
+
+	/// The Atom was extracted, or hidden.
+	virtual void atom_extracted(const Handle&) = 0;
+
+	/// The whole AtomSpace was cleared.
+	virtual void atoms_cleared(void) = 0;
+};
+
+typedef std::shared_ptr<AtomWatcher> AtomWatcherPtr;
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_ATOM_WATCHER_H
@@ -0,0 +1,496 @@
+/*
+ * opencog/atomspace/BulkLoad.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+
+#include "AtomSpace.h"
+#include "ParallelFor.h"
+
+using namespace opencog;
+
+// The number of hash partitions used for the parallel deduplication
+// and for the incoming-set batching. Should be well above the number
+// of cores, so that the work balances out.
+#define BULK_PARTITIONS 256
+
+// The number of Atoms in the batch that are processed together.
+#define BULK_CHUNK 8192
+
+namespace opencog {
+
+/**
+ * Adds a batch of Atoms to an AtomSpace, one level at a time.
+ *
+ * The batch, together with the outgoing sets of all the Links in it,
+ * is sorted by height: Nodes (and Atoms already in the AtomSpace) are
+ * at level zero, and each Link is one level above its highest child.
+ * The Atoms in one level do not depend on one-another, and so can all
+ * be added at the same time. For each level:
+ *
+ * 1) Each Atom is rebuilt over the AtomSpace versions of its children,
+ *    if needed, and looked up in the TypeIndex, without locking.
+ * 2) The Atoms that were not found are deduplicated, in parallel, in
+ *    partitions of the hash space.
+ * 3) The new Links are placed into the incoming sets of their children.
+ *    These are grouped by child, so that each child is locked once.
+ * 4) The new Atoms are placed into the TypeIndex, locking and growing
+ *    each stripe once. Any that lost a race with another thread are
+ *    undone, exactly as in AtomSpace::add().
+ *
+ * Atoms with special insertion semantics are handed to AtomSpace::add()
+ * one at a time.
+ */
+class BulkLoader
+{
+	private:
+		struct Item
+		{
+			Handle orig;    // As handed to us.
+			Handle atom;    // The version in the AtomSpace, when done.
+			size_t level;
+			size_t kids;    // Offset of the outgoing Items in _kids.
+			size_t winner;  // The Item that is inserted on our behalf.
+			bool top;       // In the batch, and not just a child.
+			bool slow;      // Must go through AtomSpace::add().
+			bool fresh;     // Not (yet) in the AtomSpace.
+			bool made;      // `atom` was inserted by us.
+		};
+
+		AtomSpace* _as;
+		std::vector<Item> _items;
+		std::vector<size_t> _kids;
+		std::unordered_map<const Atom*, size_t> _where;
+		std::vector<std::vector<size_t>> _levels;
+		std::vector<bool> _special;
+
+		size_t collect(const Handle&);
+		void prepare(Item&);
+		void slow_add(Item&);
+		void dedup(const std::vector<size_t>&, std::vector<size_t>&);
+		void install(const std::vector<size_t>&);
+		void publish(const std::vector<size_t>&);
+		void load_level(const std::vector<size_t>&);
+		void load_chunk(HandleSeq&, size_t, size_t);
+
+	public:
+		BulkLoader(AtomSpace*);
+		void load(HandleSeq&);
+};
+
+} // namespace opencog
+
+/// Spread the hash bits around, and pick a partition.
+static inline size_t partition(uint64_t h)
+{
+	return ((h * 0x9e3779b97f4a7c15ULL) >> 40) % BULK_PARTITIONS;
+}
+
+BulkLoader::BulkLoader(AtomSpace* as) : _as(as)
+{
+	// Types whose setAtomSpace() or install() do more than the plain
+	// Atom and Link versions. These have to be added in order, one
+	// at a time, by AtomSpace::add().
+	NameServer& ns = nameserver();
+	Type ntypes = ns.getNumberOfClasses();
+	_special.resize(ntypes + 1);
+	for (Type t = ATOM; t < ntypes; t++)
+		_special[t] = ns.isA(t, FRAME) or ns.isA(t, UNIQUE_LINK) or
+		              ns.isA(t, DELETE_LINK) or ns.isA(t, PATTERN_LINK) or
+		              ns.isA(t, VALUE_SHIM_LINK);
+}
+
+/// Depth-first walk, creating an Item for the Atom and everything
+/// under it. Returns the index of the Item.
+size_t BulkLoader::collect(const Handle& h)
+{
+	// Links that are already in the AtomSpace are leaves; there is no
+	// need to look at what's under them. Only the other Links are
+	// remembered, so that shared subgraphs are walked just once; Nodes
+	// get an Item each time they are seen, and are deduplicated later,
+	// along with all of the other Atoms that are equal but not the same.
+	bool walk = h->is_link() and _as != h->getAtomSpace();
+	if (walk)
+	{
+		auto it = _where.find(h.get());
+		if (_where.end() != it) return it->second;
+	}
+
+	size_t level = 0;
+	size_t kids = _kids.size();
+	if (walk)
+	{
+		const HandleSeq& oset(h->getOutgoingSet());
+		_kids.resize(kids + oset.size());
+		for (size_t k = 0; k < oset.size(); k++)
+		{
+			// A Value in the outgoing set. prepare() deals with it.
+			if (nullptr == oset[k].operator->())
+			{
+				_kids[kids + k] = SIZE_MAX;
+				continue;
+			}
+			size_t c = collect(oset[k]);
+			_kids[kids + k] = c;
+			if (level <= _items[c].level) level = _items[c].level + 1;
+		}
+		_where.emplace(h.get(), _items.size());
+	}
+
+	_items.push_back({h, Handle::UNDEFINED, level, kids, SIZE_MAX,
+	                  false, false, false, false});
+	if (_levels.size() <= level) _levels.resize(level + 1);
+	_levels[level].push_back(_items.size() - 1);
+	return _items.size() - 1;
+}
+
+/// Step 1: Find the Atom that should go into the AtomSpace, and look
+/// for it. This is the same as the first half of AtomSpace::add(),
+/// except that the children have already been added. Runs in parallel.
+void BulkLoader::prepare(Item& it)
+{
+	const Handle& orig(it.orig);
+	Handle atom(orig);
+	if (_as == orig->getAtomSpace())
+	{
+		/* Already ours; just check that it's still there, below. */
+	}
+	else if (_special[orig->get_type()])
+	{
+		it.slow = true;
+		return;
+	}
+	else if (orig->is_link())
+	{
+		const HandleSeq& oset(orig->getOutgoingSet());
+		bool need_copy = (nullptr != orig->getAtomSpace());
+		HandleSeq closet;
+		closet.reserve(oset.size());
+		for (size_t k = 0; k < oset.size(); k++)
+		{
+			// Not an Atom, or an Atom that could not be added. Let
+			// add() decide what to do about that.
+			size_t c = _kids[it.kids + k];
+			if (SIZE_MAX == c or nullptr == _items[c].atom)
+			{
+				it.slow = true;
+				return;
+			}
+
+			const Handle& hc(_items[c].atom);
+			if (hc != oset[k]) need_copy = true;
+			closet.push_back(hc);
+		}
+		if (need_copy)
+			atom = createLink(std::move(closet), orig->get_type());
+	}
+	else if (orig->getAtomSpace())
+	{
+		// A Node in some other AtomSpace; make a copy.
+		atom = createNode(orig->get_type(), std::string(orig->get_name()));
+	}
+
+	const Handle& hc(_as->typeIndex.findAtom(atom));
+	if (hc)
+	{
+		if (hc->isAbsent())
+		{
+			hc->setPresent();
+			_as->typeIndex.touch(hc);
+		}
+		it.atom = hc;
+		return;
+	}
+
+	// Extracted by some other thread, since the batch was collected.
+	if (_as == orig->getAtomSpace())
+	{
+		it.slow = true;
+		return;
+	}
+
+	if (atom == orig)
+		atom->unsetRemovalFlag();
+	else
+		atom->copyValues(orig);
+
+	it.atom = atom;
+	it.fresh = true;
+}
+
+/// Add one Atom the ordinary way. This is what AtomSpace::add_atom()
+/// does, except that the Values of child Atoms are not copied.
+void BulkLoader::slow_add(Item& it)
+{
+	try {
+		it.atom = _as->add(it.orig, false, not it.top);
+	}
+	catch (const DeleteException& ex) {
+		it.atom = Handle::UNDEFINED;
+	}
+	catch (const SilentException& ex) {
+		it.atom = _as->lookupHide(it.orig, false);
+	}
+}
+
+/// Step 2: Pick one Atom out of each group of equal new Atoms; these
+/// are the `winners`. Get them ready for insertion.
+void BulkLoader::dedup(const std::vector<size_t>& level,
+                       std::vector<size_t>& winners)
+{
+	// About a thousand Atoms per partition, at most BULK_PARTITIONS.
+	size_t nparts = 1;
+	while (nparts < BULK_PARTITIONS and nparts * 1024 < level.size())
+		nparts *= 2;
+
+	typedef std::vector<std::pair<ContentHash, size_t>> Part;
+	std::vector<Part> parts(nparts);
+	for (size_t i : level)
+	{
+		if (not _items[i].fresh) continue;
+		ContentHash hsh = _items[i].atom->get_hash();
+		parts[partition(hsh) % nparts].push_back({hsh, i});
+	}
+
+	// Sorting brings equal Atoms together; then only the neighbors
+	// with the same hash have to be compared. Ties go to the earliest
+	// Item, so that the outcome does not depend on the thread count.
+	parallel_for(nparts, [&](size_t p)
+	{
+		Part& part(parts[p]);
+		std::sort(part.begin(), part.end());
+		for (size_t lo = 0; lo < part.size(); )
+		{
+			size_t hi = lo + 1;
+			while (hi < part.size() and part[hi].first == part[lo].first)
+				hi++;
+
+			for (size_t x = lo; x < hi; x++)
+			{
+				Item& it = _items[part[x].second];
+				it.winner = part[x].second;
+				for (size_t y = lo; y < x; y++)
+				{
+					size_t w = part[y].second;
+					if (_items[w].winner == w and
+					    *_items[w].atom == *it.atom)
+					{
+						it.winner = w;
+						break;
+					}
+				}
+			}
+			lo = hi;
+		}
+	}, 1);
+
+	for (const Part& part : parts)
+		for (const auto& pr : part)
+			if (_items[pr.second].winner == pr.second)
+				winners.push_back(pr.second);
+
+	// Must be done before the Atoms become visible; see the comments
+	// in AtomSpace::add().
+	parallel_for(winners.size(), [&](size_t k)
+	{
+		const Handle& h(_items[winners[k]].atom);
+		h->setAtomSpace(_as);
+		h->keep_incoming_set();
+	});
+}
+
+/// Step 3: Place the new Links into the incoming sets of their
+/// children. This is Link::install(), turned inside-out: instead of
+/// taking the lock of each child once per parent, it is taken once.
+void BulkLoader::install(const std::vector<size_t>& winners)
+{
+	std::vector<std::pair<Atom*, size_t>> edges;
+	for (size_t i : winners)
+	{
+		const Handle& h(_items[i].atom);
+		if (not h->is_link()) continue;
+		for (const Handle& ho : h->getOutgoingSet())
+			edges.push_back({ho.get(), i});
+	}
+	if (edges.empty()) return;
+
+	// Group the edges by target.
+	std::sort(edges.begin(), edges.end());
+	std::vector<size_t> runs;
+	for (size_t e = 0; e < edges.size(); e++)
+		if (0 == e or edges[e].first != edges[e-1].first)
+			runs.push_back(e);
+	runs.push_back(edges.size());
+
+	parallel_for(runs.size() - 1, [&](size_t r)
+	{
+		size_t lo = runs[r];
+		size_t hi = runs[r+1];
+		Atom* target = edges[lo].first;
+		if (lo + 1 == hi)
+		{
+			target->insert_atom(_items[edges[lo].second].atom);
+			return;
+		}
+		HandleSeq parents;
+		parents.reserve(hi - lo);
+		for (size_t e = lo; e < hi; e++)
+			parents.push_back(_items[edges[e].second].atom);
+		target->insert_atoms(parents);
+	}, 256);
+}
+
+/// Step 4: Make the new Atoms visible.
+void BulkLoader::publish(const std::vector<size_t>& winners)
+{
+	HandleSeq batch;
+	batch.reserve(winners.size());
+	for (size_t i : winners)
+		batch.push_back(_items[i].atom);
+
+	HandleSeq found;
+	_as->typeIndex.insertAtoms(batch, found);
+
+	for (size_t k = 0; k < winners.size(); k++)
+	{
+		Item& it = _items[winners[k]];
+		if (nullptr == found[k])
+		{
+			it.made = true;
+			continue;
+		}
+
+		// Some other thread raced, and inserted it first. Undo the
+		// install above.
+		it.atom->setAtomSpace(nullptr);
+		it.atom->remove();
+		it.atom = found[k];
+	}
+
+	// The watchers hear about the Atoms that were made, a level at a
+	// time, and so the outgoing set of a Link is always reported
+	// before the Link itself.
+	if (not _as->_watched) return;
+	HandleSeq made;
+	for (size_t k = 0; k < winners.size(); k++)
+		if (nullptr == found[k])
+			made.push_back(_items[winners[k]].atom);
+	if (not made.empty()) _as->notify_added(made);
+}
+
+void BulkLoader::load_level(const std::vector<size_t>& level)
+{
+	parallel_for(level.size(),
+		[&](size_t i) { prepare(_items[level[i]]); }, 256);
+
+	// Atoms in the same level do not depend on one-another, so the
+	// ones that need special handling can be done first.
+	for (size_t i : level)
+		if (_items[i].slow) slow_add(_items[i]);
+
+	std::vector<size_t> winners;
+	dedup(level, winners);
+	install(winners);
+	publish(winners);
+
+	for (size_t i : level)
+	{
+		Item& it = _items[i];
+		if (it.fresh and it.winner != i)
+			it.atom = _items[it.winner].atom;
+	}
+}
+
+/// Add the Atoms in hs[lo, hi), and replace them by the versions in
+/// the AtomSpace.
+void BulkLoader::load_chunk(HandleSeq& hs, size_t lo, size_t hi)
+{
+	_items.clear();
+	_kids.clear();
+	_where.clear();
+	_levels.clear();
+
+	std::vector<size_t> tops(hi - lo, SIZE_MAX);
+	for (size_t i = lo; i < hi; i++)
+	{
+		if (nullptr == hs[i]) continue;
+		tops[i - lo] = collect(hs[i]);
+		_items[tops[i - lo]].top = true;
+	}
+
+	for (const std::vector<size_t>& level : _levels)
+		load_level(level);
+
+	for (size_t i = lo; i < hi; i++)
+	{
+		if (SIZE_MAX == tops[i - lo]) continue;
+		const Item& it = _items[tops[i - lo]];
+
+		// As in add_atom(): if the Atom was already there, then the
+		// Values of the one handed to us are copied onto it.
+		if (it.atom and not it.slow and not it.made and it.atom != it.orig)
+			it.atom->copyValues(it.orig);
+		hs[i] = it.atom;
+	}
+}
+
+/// The batch is loaded in chunks. Walking a huge batch level by level
+/// would touch each Atom long after it fell out of the CPU cache; the
+/// chunks are sized so that the working set stays in cache, while
+/// still being large enough to keep all of the cores busy, and to
+/// make the per-stripe and per-target locking rare.
+void BulkLoader::load(HandleSeq& hs)
+{
+	for (size_t lo = 0; lo < hs.size(); lo += BULK_CHUNK)
+		load_chunk(hs, lo, std::min(hs.size(), lo + BULK_CHUNK));
+}
+
+// ================================================================
+
+HandleSeq AtomSpace::add_atoms(HandleSeq&& hs)
+{
+	HandleSeq result(std::move(hs));
+
+	// Cannot add atoms to a read-only atomspace. But if they're
+	// already in the atomspace, return them.
+	if (_read_only)
+	{
+		for (Handle& h : result) h = get_atom(h);
+		return result;
+	}
+
+	// Frames have to search and shadow the Atoms in the spaces
+	// underneath; that goes one Atom at a time.
+	if (not _environ.empty() or _copy_on_write or _transient)
+	{
+		for (Handle& h : result) h = add_atom(h);
+		return result;
+	}
+
+	BulkLoader(this).load(result);
+	return result;
+}
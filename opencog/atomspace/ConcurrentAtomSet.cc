@@ -0,0 +1,208 @@
+/*
+ * opencog/atomspace/ConcurrentAtomSet.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdint>
+
+#include <opencog/atomspace/ConcurrentAtomSet.h>
+
+using namespace opencog;
+
+// The smallest table that is ever allocated.
+#define MIN_CAPACITY 16
+
+ConcurrentAtomSet::Table::Table(size_t cap) :
+	_mask(cap - 1),
+	_slots(new Slot[cap]()),
+	_owners(new Handle[cap])
+{
+}
+
+ConcurrentAtomSet::Table::~Table()
+{
+	delete[] _slots;
+	delete[] _owners;
+}
+
+// ================================================================
+
+ConcurrentAtomSet::ConcurrentAtomSet(void) :
+	_table(nullptr), _size(0), _tombs(0)
+{
+}
+
+ConcurrentAtomSet::~ConcurrentAtomSet()
+{
+	delete _table.load();
+}
+
+static inline bool same_atom(const Atom* a, ContentHash hsh, const Handle& h)
+{
+	if (a == h.get()) return true;
+	return a->get_hash() == hsh and *a == *h;
+}
+
+Handle ConcurrentAtomSet::find(const Handle& h) const
+{
+	ContentHash hsh = h->get_hash();
+
+	EpochGuard guard;
+	const Table* t = _table.load(std::memory_order_acquire);
+	if (nullptr == t) return Handle::UNDEFINED;
+
+	for (size_t i = hsh & t->_mask; ; i = (i+1) & t->_mask)
+	{
+		const Slot& s = t->_slots[i];
+		Atom* a = s._atom.load(std::memory_order_acquire);
+		if (nullptr == a) return Handle::UNDEFINED;
+		if (tombstone() == a) continue;
+		if (s._hash.load(std::memory_order_relaxed) != hsh) continue;
+		if (not same_atom(a, hsh, h)) continue;
+
+		// The epoch guard keeps the Atom alive; it is safe to take
+		// a new reference to it.
+		return Handle(std::static_pointer_cast<Atom>(a->shared_from_this()));
+	}
+}
+
+Handle ConcurrentAtomSet::insert(const Handle& h)
+{
+	Table* t = _table.load(std::memory_order_relaxed);
+
+	// Keep the load factor under 3/4, counting tombstones.
+	if (nullptr == t or 4 * (_size + _tombs + 1) > 3 * (t->_mask + 1))
+	{
+		rehash(2 * (_size + 1));
+		t = _table.load(std::memory_order_relaxed);
+	}
+
+	ContentHash hsh = h->get_hash();
+	size_t tomb = SIZE_MAX;
+	size_t i = hsh & t->_mask;
+	for (; ; i = (i+1) & t->_mask)
+	{
+		const Slot& s = t->_slots[i];
+		Atom* a = s._atom.load(std::memory_order_relaxed);
+		if (nullptr == a) break;
+		if (tombstone() == a)
+		{
+			if (SIZE_MAX == tomb) tomb = i;
+			continue;
+		}
+		if (s._hash.load(std::memory_order_relaxed) != hsh) continue;
+		if (same_atom(a, hsh, h)) return t->_owners[i];
+	}
+
+	// Re-use the first tombstone on the probe path, if any.
+	if (SIZE_MAX != tomb)
+	{
+		i = tomb;
+		_tombs--;
+	}
+
+	// Publish the hash before the Atom; readers check the Atom first.
+	Slot& s = t->_slots[i];
+	t->_owners[i] = h;
+	s._hash.store(hsh, std::memory_order_relaxed);
+	s._atom.store(h.get(), std::memory_order_release);
+	_size.fetch_add(1, std::memory_order_relaxed);
+	return Handle::UNDEFINED;
+}
+
+size_t ConcurrentAtomSet::erase(const Handle& h)
+{
+	Table* t = _table.load(std::memory_order_relaxed);
+	if (nullptr == t) return 0;
+
+	ContentHash hsh = h->get_hash();
+	for (size_t i = hsh & t->_mask; ; i = (i+1) & t->_mask)
+	{
+		Slot& s = t->_slots[i];
+		Atom* a = s._atom.load(std::memory_order_relaxed);
+		if (nullptr == a) return 0;
+		if (tombstone() == a) continue;
+		if (s._hash.load(std::memory_order_relaxed) != hsh) continue;
+		if (not same_atom(a, hsh, h)) continue;
+
+		// Readers may still be looking at this Atom; keep it alive
+		// until they are done. (Handle has no real move ctor; swap.)
+		s._atom.store(tombstone(), std::memory_order_release);
+		Handle* dead = new Handle();
+		dead->swap(t->_owners[i]);
+		Epoch::retire(dead);
+		_size.fetch_sub(1, std::memory_order_relaxed);
+		_tombs++;
+		return 1;
+	}
+}
+
+/// Move all Atoms into a fresh table, big enough for `n` of them,
+/// dropping tombstones along the way.
+void ConcurrentAtomSet::rehash(size_t n)
+{
+	size_t cap = MIN_CAPACITY;
+	while (cap < n) cap *= 2;
+
+	Table* nt = new Table(cap);
+	Table* t = _table.load(std::memory_order_relaxed);
+	if (t)
+	{
+		for (size_t i = 0; i <= t->_mask; i++)
+		{
+			Atom* a = t->_slots[i]._atom.load(std::memory_order_relaxed);
+			if (not is_atom(a)) continue;
+
+			ContentHash hsh = t->_slots[i]._hash.load(std::memory_order_relaxed);
+			size_t j = hsh & nt->_mask;
+			while (nullptr != nt->_slots[j]._atom.load(std::memory_order_relaxed))
+				j = (j+1) & nt->_mask;
+
+			nt->_owners[j].swap(t->_owners[i]);
+			nt->_slots[j]._hash.store(hsh, std::memory_order_relaxed);
+			nt->_slots[j]._atom.store(a, std::memory_order_relaxed);
+		}
+	}
+
+	// The release publishes the new slots. Readers that are still
+	// probing the old table will find what they would have found
+	// before; the Atoms themselves are kept alive by the new table.
+	_table.store(nt, std::memory_order_release);
+	_tombs = 0;
+	if (t) Epoch::retire(t);
+}
+
+void ConcurrentAtomSet::reserve(size_t n)
+{
+	Table* t = _table.load(std::memory_order_relaxed);
+	size_t have = t ? 3 * (t->_mask + 1) / 4 : 0;
+	if (have < n + _tombs) rehash((4 * n) / 3 + 1);
+}
+
+void ConcurrentAtomSet::clear(void)
+{
+	Table* t = _table.exchange(nullptr, std::memory_order_acq_rel);
+	_size = 0;
+	_tombs = 0;
+
+	// The old table still holds references to all of the Atoms, and
+	// will release them only after the readers are done.
+	if (t) Epoch::retire(t);
+}
@@ -0,0 +1,201 @@
+/*
+ * opencog/atomspace/ConcurrentAtomSet.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_CONCURRENT_ATOM_SET_H
+#define _OPENCOG_CONCURRENT_ATOM_SET_H
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Epoch.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A hash set of Atoms, keyed on the Atom hash, that can be searched
+ * without taking any locks. Open addressing, with linear probing.
+ *
+ * The find() method is lock-free, and may run concurrently with any
+ * other method. All other methods modify the set, or walk it, and
+ * the caller must serialize them with a lock. That is, this is a
+ * read-mostly set: lookups (which dominate AtomSpace traffic) never
+ * wait, while inserts and removals wait only for one-another.
+ *
+ * Memory safety for the lock-free readers is provided by epoch-based
+ * reclamation: the Handle of an erased Atom, and the slot array of a
+ * table that was outgrown, are retired, not released, until all of
+ * the readers that might have seen them have finished.
+ *
+ * Like std::unordered_set<Handle>, equality is content-equality:
+ * find() returns the Atom in the set that is equal to the argument,
+ * even if the argument is a different (not yet inserted) C++ object.
+ */
+class ConcurrentAtomSet
+{
+	private:
+		struct Slot
+		{
+			// A copy of the Atom hash, so that probing does not
+			// have to touch the Atom itself, which is a cache miss.
+			std::atomic<ContentHash> _hash;
+			std::atomic<Atom*> _atom;
+		};
+
+		struct Table
+		{
+			size_t _mask;
+			Slot* _slots;
+
+			// The references that keep the Atoms alive. Only writers
+			// touch these; readers see only the Slot pointers.
+			Handle* _owners;
+
+			Table(size_t);
+			~Table();
+		};
+
+		// Marks a slot whose Atom was erased. Probe sequences
+		// continue past it; an empty (null) slot ends them.
+		static Atom* tombstone(void)
+		{
+			return reinterpret_cast<Atom*>(uintptr_t(1));
+		}
+
+		static bool is_atom(const Atom* a)
+		{
+			return nullptr != a and tombstone() != a;
+		}
+
+		std::atomic<Table*> _table;
+		std::atomic<size_t> _size;
+		size_t _tombs;
+
+		void rehash(size_t);
+
+	public:
+		ConcurrentAtomSet(void);
+		~ConcurrentAtomSet();
+		ConcurrentAtomSet(const ConcurrentAtomSet&) = delete;
+		ConcurrentAtomSet& operator=(const ConcurrentAtomSet&) = delete;
+
+		/// Return the Atom in the set that is equal to `h`, or
+		/// Handle::UNDEFINED. Lock-free.
+		Handle find(const Handle& h) const;
+
+		/// If an Atom equal to `h` is already in the set, return it.
+		/// Otherwise, insert `h` and return Handle::UNDEFINED.
+		Handle insert(const Handle& h);
+
+		/// Remove the Atom equal to `h`; return the number removed.
+		size_t erase(const Handle& h);
+
+		void clear(void);
+
+		/// Make room for at least `n` Atoms, without rehashing.
+		void reserve(size_t n);
+
+		size_t size(void) const
+		{ return _size.load(std::memory_order_relaxed); }
+		bool empty(void) const { return 0 == size(); }
+
+		/// Call `fn` on each Atom in the set, without taking any lock,
+		/// and without blocking writers. Atoms inserted or erased
+		/// during the walk may or may not be visited; all others are
+		/// visited exactly once. Nothing is copied, but, for as long
+		/// as the walk lasts, Atoms erased by others are not released.
+		template<typename FN>
+		void for_each(FN fn) const
+		{
+			EpochGuard guard;
+
+			// If the table is outgrown during the walk, we keep going
+			// on the old one; it's still alive, thanks to the guard.
+			const Table* t = _table.load(std::memory_order_acquire);
+			if (nullptr == t) return;
+			for (size_t i = 0; i <= t->_mask; i++)
+			{
+				Atom* a = t->_slots[i]._atom.load(std::memory_order_acquire);
+				if (not is_atom(a)) continue;
+				fn(Handle(std::static_pointer_cast<Atom>(a->shared_from_this())));
+			}
+		}
+
+		/// Iterator for walking the set, while holding the lock that
+		/// serializes writers. It is not safe against concurrent
+		/// insertion or removal.
+		class const_iterator
+		{
+			private:
+				const Table* _t;
+				size_t _i;
+
+				void skip(void)
+				{
+					while (_i <= _t->_mask and
+					       not is_atom(_t->_slots[_i]._atom.load(
+					            std::memory_order_relaxed)))
+						_i++;
+				}
+
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef Handle value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const Handle* pointer;
+				typedef const Handle& reference;
+
+				const_iterator(const Table* t, size_t i) :
+					_t(t), _i(i) { if (_t) skip(); }
+
+				reference operator*() const { return _t->_owners[_i]; }
+				pointer operator->() const { return &_t->_owners[_i]; }
+				const_iterator& operator++()
+				{ _i++; skip(); return *this; }
+				const_iterator operator++(int)
+				{ const_iterator tmp(*this); ++*this; return tmp; }
+
+				bool operator==(const const_iterator& other) const
+				{ return _i == other._i; }
+				bool operator!=(const const_iterator& other) const
+				{ return _i != other._i; }
+		};
+
+		const_iterator begin(void) const
+		{ return const_iterator(_table.load(std::memory_order_acquire), 0); }
+		const_iterator end(void) const
+		{
+			const Table* t = _table.load(std::memory_order_acquire);
+			return const_iterator(nullptr, t ? t->_mask + 1 : 0);
+		}
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_CONCURRENT_ATOM_SET_H
@@ -76,13 +76,6 @@ void Frame::scrub_incoming_set(void)
 	std::vector<Type> framet;
 	nameserver().getChildrenRecursive(FRAME, back_inserter(framet));
 	for (Type t : framet)
-	{
-		auto bucket = _incoming_set._iset.find(t);
-		for (auto bi = bucket->second.begin(); bi != bucket->second.end();)
-		{
-			if (0 == bi->use_count())
-				bi = bucket->second.erase(bi);
-			else bi++;
-		}
-	}
+		_incoming_set.erase_if(t,
+			[](const WinkPtr& w) { return 0 == w.use_count(); });
 }
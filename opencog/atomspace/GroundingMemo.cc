@@ -0,0 +1,95 @@
+/*
+ * opencog/atomspace/GroundingMemo.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atomspace/GroundingMemo.h>
+
+using namespace opencog;
+
+// About 100 bytes an entry, plus the keys; so a few tens of MBytes,
+// at most. The groundings of the most recent searches come back
+// quickly, after it is emptied.
+size_t GroundingMemo::max_size = 1 << 18;
+
+GroundingMemo::GroundingMemo(const AtomSpace* as) :
+	_as(as), _hits(0), _misses(0)
+{
+}
+
+size_t GroundingMemo::stamp(Type t) const
+{
+	return _as->get_type_stamp(t);
+}
+
+Handle GroundingMemo::intern(const Handle& scope)
+{
+	{
+		std::shared_lock<std::shared_mutex> lck(_mtx);
+		const auto& it = _scopes.find(scope);
+		if (it != _scopes.end()) return *it;
+	}
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	return *_scopes.insert(scope).first;
+}
+
+bool GroundingMemo::lookup(const HandleSeq& key, size_t stamp,
+                           Handle& gnd) const
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	const auto& it = _memo.find(key);
+	if (it == _memo.end() or it->second.stamp != stamp)
+	{
+		_misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	_hits.fetch_add(1, std::memory_order_relaxed);
+	gnd = it->second.grounding;
+	return true;
+}
+
+void GroundingMemo::insert(HandleSeq&& key, size_t stamp, const Handle& gnd)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	if (max_size <= _memo.size())
+	{
+		_memo.clear();
+		_scopes.clear();
+	}
+	_memo.insert_or_assign(std::move(key), Entry{gnd, stamp});
+}
+
+void GroundingMemo::clear(void)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	_memo.clear();
+	_scopes.clear();
+	_hits = 0;
+	_misses = 0;
+}
+
+size_t GroundingMemo::size(void) const
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	return _memo.size();
+}
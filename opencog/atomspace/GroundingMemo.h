@@ -0,0 +1,113 @@
+/*
+ * opencog/atomspace/GroundingMemo.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_GROUNDING_MEMO_H
+#define _OPENCOG_GROUNDING_MEMO_H
+
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * A memo of the groundings of pattern-matcher clauses, kept by the
+ * AtomSpace, so that they can be re-used from one search to the next.
+ *
+ * The key is a HandleSeq: the clause, wrapped in a scope (so that
+ * alpha-equivalent clauses, in different queries, have equal keys),
+ * followed by the groundings of its variables. The value is the
+ * grounding of the whole clause, or nullptr, if the clause could not
+ * be grounded.
+ *
+ * Each entry is stamped with the TypeIndex stamp of the Type of the
+ * clause, at the time that it was made. Adding, removing, hiding or
+ * un-hiding an Atom of that Type changes the stamp, and so all of
+ * the entries for that Type go stale. Stale entries are ignored, and
+ * over-written when the clause is grounded again.
+ *
+ * The memo does not know anything about patterns; the pattern engine
+ * decides what goes into it. All methods are thread-safe.
+ */
+class GroundingMemo
+{
+	struct Entry
+	{
+		Handle grounding;
+		size_t stamp;
+	};
+
+	const AtomSpace* _as;
+
+	mutable std::shared_mutex _mtx;
+	std::unordered_map<HandleSeq, Entry> _memo;
+	std::unordered_set<Handle> _scopes;
+
+	mutable std::atomic<size_t> _hits;
+	mutable std::atomic<size_t> _misses;
+
+public:
+	GroundingMemo(const AtomSpace*);
+	GroundingMemo(const GroundingMemo&) = delete;
+	GroundingMemo& operator=(const GroundingMemo&) = delete;
+
+	/// The memo is emptied when it grows past this many entries.
+	static size_t max_size;
+
+	/// The current stamp for the Type, in the AtomSpace, and all of
+	/// the spaces under it.
+	size_t stamp(Type) const;
+
+	/// Return the scope that is alpha-equivalent to the argument,
+	/// if there is one; else remember the argument and return it.
+	/// Keys made with the same scope compare more quickly.
+	Handle intern(const Handle&);
+
+	/// Look up the key. Return true and set the grounding if there
+	/// is an entry, made at the given stamp. The grounding is
+	/// nullptr, if the clause could not be grounded.
+	bool lookup(const HandleSeq&, size_t, Handle&) const;
+
+	/// Record the grounding, or nullptr for no grounding.
+	void insert(HandleSeq&&, size_t, const Handle&);
+
+	void clear(void);
+
+	size_t size(void) const;
+	size_t hits(void) const { return _hits; }
+	size_t misses(void) const { return _misses; }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_GROUNDING_MEMO_H
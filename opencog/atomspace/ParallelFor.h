@@ -0,0 +1,84 @@
+/*
+ * opencog/atomspace/ParallelFor.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PARALLEL_FOR_H
+#define _OPENCOG_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <opencog/atoms/base/WorkerPool.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Call `fn(i)` for each `i` in [0, n), spread over all of the cores,
+/// on the threads of the shared WorkerPool. Work is handed out in
+/// chunks of `grain` indexes; jobs that are too small to be split up
+/// are run in the caller's thread. If `fn` throws, the rest of the
+/// work is dropped, and the first exception is re-thrown in the
+/// caller, after all of the threads have stopped.
+///
+/// This is for the internal use of the AtomSpace bulk operations; it
+/// is not meant to be a general-purpose thread pool.
+template<typename FN>
+void parallel_for(size_t n, FN fn, size_t grain = 1024)
+{
+	if (0 == grain) grain = 1;
+	size_t nchunks = (n + grain - 1) / grain;
+	size_t nthreads = std::min<size_t>(std::thread::hardware_concurrency(),
+	                                   nchunks);
+	if (nthreads <= 1)
+	{
+		for (size_t i = 0; i < n; i++) fn(i);
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	workerpool().run(nthreads, [&](size_t)
+	{
+		try
+		{
+			while (true)
+			{
+				size_t lo = next.fetch_add(grain);
+				if (n <= lo) break;
+				size_t hi = std::min(n, lo + grain);
+				for (size_t i = lo; i < hi; i++) fn(i);
+			}
+		}
+		catch (...)
+		{
+			next = n;
+			throw;
+		}
+	});
+}
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_PARALLEL_FOR_H
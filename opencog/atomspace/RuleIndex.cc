@@ -0,0 +1,366 @@
+/*
+ * opencog/atomspace/RuleIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atomspace/RuleIndex.h>
+
+using namespace opencog;
+
+// The atom types are not set until the shared libraries are loaded;
+// so these cannot be static constants.
+#define END  Sym(NOTYPE, 0)
+#define VAR  Sym(VARIABLE_NODE, 0)
+#define GLOB Sym(GLOB_NODE, 0)
+
+RuleIndex::RuleIndex(AtomSpace* as) :
+	_as(as), _size(0)
+{
+}
+
+/// Watch first, and then look, so that nothing is missed. Anything
+/// added in the meantime waits for the lock, and is then found to be
+/// there already.
+void RuleIndex::fill(const RuleIndexPtr& self)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	_as->add_watcher(self);
+	_as->for_each_by_type(LINK,
+		[&](const Handle& h) { insert(h); }, true, false);
+}
+
+/* ======================================================== */
+
+RuleIndex::Sym RuleIndex::sym(const Handle& h)
+{
+	Type t = h->get_type();
+	if (VARIABLE_NODE == t or GLOB_NODE == t or h->is_link())
+		return Sym(t, 0);
+	return Sym(t, (uintptr_t) h.get());
+}
+
+/// The skeleton, in prefix order. The outgoing set of an ordered Link
+/// follows it, and then an END. An UnorderedLink stands alone.
+void RuleIndex::flatten(const Handle& h, std::vector<Item>& flat)
+{
+	size_t at = flat.size();
+	flat.push_back({sym(h), 0});
+	if (h->is_link() and
+	    not nameserver().isA(h->get_type(), UNORDERED_LINK))
+	{
+		for (const Handle& ho : h->getOutgoingSet())
+			flatten(ho, flat);
+		flat.push_back({END, flat.size() + 1});
+	}
+	flat[at].skip = flat.size();
+}
+
+bool RuleIndex::has_glob(const Handle& h)
+{
+	if (GLOB_NODE == h->get_type()) return true;
+	if (not h->is_link()) return false;
+	for (const Handle& ho : h->getOutgoingSet())
+		if (has_glob(ho)) return true;
+	return false;
+}
+
+/// The same as Recognizer::loose_match(); the rule side is a Sym.
+bool RuleIndex::loose(const Handle& h, const Sym& s)
+{
+	return VAR == s or sym(h) == s;
+}
+
+/* ======================================================== */
+
+static bool has_var(const Handle& h)
+{
+	if (VARIABLE_NODE == h->get_type()) return true;
+	if (not h->is_link()) return false;
+	for (const Handle& ho : h->getOutgoingSet())
+		if (has_var(ho)) return true;
+	return false;
+}
+
+/// The tree that the Link goes into, and its key there; or nullptr,
+/// if it is not a rule, or if it is one that can never match.
+RuleIndex::Tree* RuleIndex::key(const Handle& h, std::vector<Item>& flat)
+{
+	if (not h->is_link() or
+	    nameserver().isA(h->get_type(), UNORDERED_LINK)) return nullptr;
+
+	const HandleSeq& oset = h->getOutgoingSet();
+	for (const Handle& ho : oset)
+	{
+		if (GLOB_NODE != ho->get_type()) continue;
+		flat.push_back({sym(h), 0});
+		for (const Handle& hg : oset)
+			flat.push_back({sym(hg), 0});
+		return &_globby;
+	}
+
+	if (has_glob(h) or not has_var(h)) return nullptr;
+	flatten(h, flat);
+	return &_plain;
+}
+
+/// The lock must be held; `flat` is the key found by key().
+void RuleIndex::insert(Tree* t, const std::vector<Item>& flat,
+                       const Handle& h)
+{
+	for (const Item& it : flat)
+	{
+		std::unique_ptr<Tree>& nt = t->next[it.sym];
+		if (nullptr == nt) nt.reset(new Tree());
+		t = nt.get();
+	}
+	if (t->rules.end() != std::find(t->rules.begin(), t->rules.end(), h))
+		return;
+	t->rules.push_back(h);
+	_size++;
+}
+
+void RuleIndex::insert(const Handle& h)
+{
+	std::vector<Item> flat;
+	Tree* t = key(h, flat);
+	if (t) insert(t, flat, h);
+}
+
+/// Return true if the tree is now empty, and can be dropped.
+bool RuleIndex::remove(Tree& t, const std::vector<Item>& flat,
+                       size_t i, const Handle& h)
+{
+	if (flat.size() == i)
+	{
+		auto it = std::find(t.rules.begin(), t.rules.end(), h);
+		if (t.rules.end() == it) return false;
+		t.rules.erase(it);
+		_size--;
+		return t.rules.empty() and t.next.empty();
+	}
+
+	auto nt = t.next.find(flat[i].sym);
+	if (t.next.end() == nt) return false;
+	if (remove(*nt->second, flat, i+1, h))
+		t.next.erase(nt);
+	return t.rules.empty() and t.next.empty();
+}
+
+/* ======================================================== */
+
+/// Walk the skeleton of the input down the tree. A variable skips
+/// over the whole sub-tree at that position, but not over an END.
+void RuleIndex::find_plain(const Tree& t, size_t i, Lookup& lk) const
+{
+	if (lk.flat.size() == i)
+	{
+		lk.found.insert(lk.found.end(), t.rules.begin(), t.rules.end());
+		return;
+	}
+
+	const Item& it = lk.flat[i];
+	auto nt = t.next.find(it.sym);
+	if (t.next.end() != nt)
+		find_plain(*nt->second, i+1, lk);
+
+	if (END == it.sym) return;
+	nt = t.next.find(VAR);
+	if (t.next.end() != nt)
+		find_plain(*nt->second, it.skip, lk);
+}
+
+/// One turn of the loop in Recognizer::fuzzy_match(), for all of the
+/// rules under the tree at once. The rules under the tree all start
+/// the same way; the input is matched up to `ip`, and `last` is the
+/// last thing in the rules so far. The index into the rules is the
+/// depth of the tree, and need not be tracked.
+void RuleIndex::find_globby(const Tree& t, size_t ip, const Sym* last,
+                            bool glob, Lookup& lk) const
+{
+	size_t n = lk.top.size();
+
+	// The rules that end here. If there's more input, it has to match
+	// the last thing in the rule.
+	if (glob and not t.rules.empty())
+	{
+		bool ok = true;
+		for (size_t k = ip; ok and k < n; k++)
+			ok = loose(lk.top[k], *last);
+		if (ok)
+			lk.found.insert(lk.found.end(), t.rules.begin(), t.rules.end());
+	}
+
+	if (t.next.empty()) return;
+	if (ip == n) ip--;
+
+	auto nt = t.next.find(sym(lk.top[ip]));
+	if (t.next.end() != nt)
+		find_globby(*nt->second, ip+1, &nt->first, glob, lk);
+
+	nt = t.next.find(VAR);
+	if (t.next.end() != nt)
+		find_globby(*nt->second, ip+1, &nt->first, glob, lk);
+
+	nt = t.next.find(GLOB);
+	if (t.next.end() != nt)
+		after_glob(*nt->second, ip, lk);
+}
+
+/// A glob at the end, or a glob followed by a glob, matches whatever
+/// is left. Otherwise, the glob eats up the input, up to the first
+/// match for what comes after the glob; that is a different place for
+/// each thing that might come after it.
+void RuleIndex::after_glob(const Tree& t, size_t ip, Lookup& lk) const
+{
+	size_t n = lk.top.size();
+	lk.found.insert(lk.found.end(), t.rules.begin(), t.rules.end());
+
+	auto nt = t.next.find(GLOB);
+	if (t.next.end() != nt)
+		find_all(*nt->second, lk.found);
+
+	nt = t.next.find(VAR);
+	if (t.next.end() != nt)
+		find_globby(*nt->second, ip+1, &nt->first, true, lk);
+
+	std::vector<Sym> seen;
+	for (size_t k = ip; k < n; k++)
+	{
+		Sym s(sym(lk.top[k]));
+		if (seen.end() != std::find(seen.begin(), seen.end(), s))
+			continue;
+		seen.push_back(s);
+
+		nt = t.next.find(s);
+		if (t.next.end() != nt)
+			find_globby(*nt->second, k+1, &nt->first, true, lk);
+	}
+}
+
+void RuleIndex::find_all(const Tree& t, HandleSeq& found)
+{
+	found.insert(found.end(), t.rules.begin(), t.rules.end());
+	for (const auto& nt : t.next)
+		find_all(*nt.second, found);
+}
+
+/* ======================================================== */
+
+static bool is_special(const Handle& h)
+{
+	Type t = h->get_type();
+	if (VARIABLE_NODE == t or GLOB_NODE == t or
+	    QUOTE_LINK == t or UNQUOTE_LINK == t or LOCAL_QUOTE_LINK == t or
+	    CHOICE_LINK == t or PRESENT_LINK == t or ABSENT_LINK == t or
+	    ALWAYS_LINK == t or SIGNATURE_LINK == t)
+		return true;
+
+	if (not h->is_link()) return false;
+	for (const Handle& ho : h->getOutgoingSet())
+		if (is_special(ho)) return true;
+	return false;
+}
+
+bool RuleIndex::lookup(const Handle& input, HandleSeq& found) const
+{
+	if (not input->is_link() or 0 == input->get_arity() or
+	    nameserver().isA(input->get_type(), UNORDERED_LINK) or
+	    is_special(input))
+		return false;
+
+	Lookup lk{{}, input->getOutgoingSet(), found};
+	flatten(input, lk.flat);
+
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	find_plain(_plain, 0, lk);
+
+	auto nt = _globby.next.find(sym(input));
+	if (_globby.next.end() != nt)
+		find_globby(*nt->second, 0, nullptr, false, lk);
+	return true;
+}
+
+size_t RuleIndex::size(void) const
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	return _size;
+}
+
+/* ======================================================== */
+
+/// Most Links are not rules; finding that out takes no lock. Neither
+/// does working out the key of the ones that are.
+void RuleIndex::atom_added(const Handle& h)
+{
+	std::vector<Item> flat;
+	Tree* t = key(h, flat);
+	if (nullptr == t) return;
+
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	insert(t, flat, h);
+}
+
+/// A batch from add_atoms() is sorted out without the lock, and then
+/// the rules in it are all put in, under the lock, at once.
+void RuleIndex::atoms_added(const HandleSeq& hs)
+{
+	std::vector<std::pair<Tree*, std::vector<Item>>> keys;
+	HandleSeq rules;
+	for (const Handle& h : hs)
+	{
+		std::vector<Item> flat;
+		Tree* t = key(h, flat);
+		if (nullptr == t) continue;
+		keys.emplace_back(t, std::move(flat));
+		rules.push_back(h);
+	}
+	if (rules.empty()) return;
+
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	for (size_t i = 0; i < rules.size(); i++)
+		insert(keys[i].first, keys[i].second, rules[i]);
+}
+
+void RuleIndex::atom_extracted(const Handle& h)
+{
+	std::vector<Item> flat;
+	Tree* t = key(h, flat);
+	if (nullptr == t) return;
+
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	remove(*t, flat, 0, h);
+}
+
+void RuleIndex::atoms_cleared(void)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	_plain.next.clear();
+	_plain.rules.clear();
+	_globby.next.clear();
+	_globby.rules.clear();
+	_size = 0;
+}
+
+/* ===================== END OF FILE ===================== */
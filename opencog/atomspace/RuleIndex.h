@@ -0,0 +1,152 @@
+/*
+ * opencog/atomspace/RuleIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_RULE_INDEX_H
+#define _OPENCOG_RULE_INDEX_H
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/types.h>
+#include <opencog/atomspace/AtomWatcher.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * A discrimination tree over the "rules" in an AtomSpace: the Links
+ * that have a VariableNode or a GlobNode in them. It is used by the
+ * Recognizer (the DualLink), to find the rules that might match a
+ * given (constant) input, without looking at the others.
+ *
+ * Each rule is filed under its skeleton: the sequence of its types and
+ * constant Nodes, in the order that they appear, with each variable
+ * standing for a whole sub-tree. Finding the rules for an input walks
+ * the skeleton of the input down the tree, taking the variable
+ * branches as well as the matching ones; so the work done depends on
+ * the size of the input, and on the number of rules that match, and
+ * not on the number of rules.
+ *
+ * The lookup finds every rule that the Recognizer could accept, and a
+ * few more; the Recognizer still has to check each one. It follows
+ * the Recognizer's rules for matching, as they are:
+ *
+ * -- Rules with a GlobNode in their outgoing set are matched with the
+ *    greedy, left-to-right walk of Recognizer::fuzzy_match(). Only the
+ *    top level is looked at; Links under it are compared by type.
+ *
+ * -- Rules without any GlobNode are matched in the ordinary way, all
+ *    the way down. The sub-trees of an UnorderedLink are not looked
+ *    at, as they may be matched in any order.
+ *
+ * -- Rules with GlobNodes further down, but not at the top, are never
+ *    accepted, and are not kept.
+ *
+ * The index is kept up to date as Atoms are added and extracted; see
+ * AtomWatcher. It only knows about the Atoms in the one AtomSpace, and
+ * not those underneath it. All methods are thread-safe.
+ */
+class RuleIndex : public AtomWatcher
+{
+	// A Node, or the type of a Link; or a variable, a glob, or the
+	// end of an outgoing set.
+	typedef std::pair<Type, uintptr_t> Sym;
+
+	struct Tree
+	{
+		std::map<Sym, std::unique_ptr<Tree>> next;
+		HandleSeq rules;
+	};
+
+	// A position in the skeleton of the input; and where the sub-tree
+	// that starts there ends.
+	struct Item
+	{
+		Sym sym;
+		size_t skip;
+	};
+
+	struct Lookup
+	{
+		std::vector<Item> flat;
+		const HandleSeq& top;
+		HandleSeq& found;
+	};
+
+	AtomSpace* _as;
+	mutable std::shared_mutex _mtx;
+	Tree _plain;
+	Tree _globby;
+	size_t _size;
+
+	static Sym sym(const Handle&);
+	static void flatten(const Handle&, std::vector<Item>&);
+	static bool has_glob(const Handle&);
+	static bool loose(const Handle&, const Sym&);
+
+	Tree* key(const Handle&, std::vector<Item>&);
+	void insert(Tree*, const std::vector<Item>&, const Handle&);
+	void insert(const Handle&);
+	bool remove(Tree&, const std::vector<Item>&, size_t, const Handle&);
+
+	void find_plain(const Tree&, size_t, Lookup&) const;
+	void find_globby(const Tree&, size_t, const Sym*, bool,
+	                 Lookup&) const;
+	void after_glob(const Tree&, size_t, Lookup&) const;
+	static void find_all(const Tree&, HandleSeq&);
+
+public:
+	RuleIndex(AtomSpace*);
+	RuleIndex(const RuleIndex&) = delete;
+	RuleIndex& operator=(const RuleIndex&) = delete;
+
+	/// Start watching the AtomSpace, and index what is already in it.
+	void fill(const std::shared_ptr<RuleIndex>&);
+
+	/// Append the rules that might match the input, and return true;
+	/// or return false, if the input is not one that the index can
+	/// handle. That is: an UnorderedLink, a Node, an empty Link, or
+	/// anything with variables, globs, quotes or choices in it.
+	bool lookup(const Handle&, HandleSeq&) const;
+
+	/// The number of rules in the index.
+	size_t size(void) const;
+
+	virtual void atom_added(const Handle&);
+	virtual void atoms_added(const HandleSeq&);
+	virtual void atom_extracted(const Handle&);
+	virtual void atoms_cleared(void);
+};
+
+typedef std::shared_ptr<RuleIndex> RuleIndexPtr;
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_RULE_INDEX_H
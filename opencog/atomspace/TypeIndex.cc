@@ -19,36 +19,205 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "TypeIndex.h"
+#include "ParallelFor.h"
 #include <opencog/atoms/atom_types/NameServer.h>
 
 using namespace opencog;
 
+AtomStripe* TypeShard::alloc(void)
+{
+	AtomStripe* fresh = new AtomStripe[_nstripes];
+	AtomStripe* expect = nullptr;
+	if (_stripes.compare_exchange_strong(expect, fresh,
+	                                     std::memory_order_acq_rel))
+		return fresh;
+
+	// Some other thread raced, and allocated first. Use theirs.
+	delete[] fresh;
+	return expect;
+}
+
+// ================================================================
+
 TypeIndex::TypeIndex(void) :
-	_nameserver(nameserver())
+	_nameserver(nameserver()),
+	_filter(nullptr),
+	_covered(false)
 {
 	resize();
 }
 
+TypeIndex::~TypeIndex()
+{
+	delete _filter.load();
+}
+
+/// The types that, in practice, hold most of the Atoms in large
+/// datasets, and thus see most of the insert traffic, get striped.
+size_t TypeIndex::num_stripes(Type t) const
+{
+	if (LIST_LINK == t or EVALUATION_LINK == t or EDGE_LINK == t or
+	    MEMBER_LINK == t or INHERITANCE_LINK == t or SET_LINK == t or
+	    CONCEPT_NODE == t or PREDICATE_NODE == t)
+		return TYPE_INDEX_STRIPES;
+	return 1;
+}
+
 void TypeIndex::resize(void)
 {
-	_num_types = nameserver().getNumberOfClasses();
 	TYPE_INDEX_UNIQUE_LOCK;
-	_idx.resize(_num_types + 1);
+	_num_types = _nameserver.getNumberOfClasses();
+	_idx.reserve(_num_types + 1);
+	for (size_t t = _idx.size(); t <= _num_types; t++)
+		_idx.emplace_back(num_stripes(t));
+}
+
+void TypeIndex::use_filter(void)
+{
+	if (nullptr == _filter.load())
+		_filter = new AtomFilter(TYPE_INDEX_FILTER_BITS);
+}
+
+void TypeIndex::insertAtoms(const HandleSeq& atoms, HandleSeq& found)
+{
+	found.assign(atoms.size(), Handle::UNDEFINED);
+
+	// Sort the batch out by stripe.
+	std::vector<std::pair<AtomStripe*, size_t>> bystripe;
+	std::vector<TypeShard*> shard(atoms.size());
+	bystripe.reserve(atoms.size());
+	for (size_t i = 0; i < atoms.size(); i++)
+	{
+		const Handle& h(atoms[i]);
+		shard[i] = &_idx.at(h->get_type());
+		bystripe.push_back({&shard[i]->get_stripe(h), i});
+	}
+	std::sort(bystripe.begin(), bystripe.end());
+
+	std::vector<size_t> runs;
+	for (size_t i = 0; i < bystripe.size(); i++)
+		if (0 == i or bystripe[i].first != bystripe[i-1].first)
+			runs.push_back(i);
+	runs.push_back(bystripe.size());
+
+	auto fill = [&](size_t r)
+	{
+		size_t lo = runs[r];
+		size_t hi = runs[r+1];
+		AtomStripe& s(*bystripe[lo].first);
+
+		STRIPE_UNIQUE_LOCK(s);
+		s._atoms.reserve(s._atoms.size() + hi - lo);
+		for (size_t k = lo; k < hi; k++)
+		{
+			size_t i = bystripe[k].second;
+#if USE_CONCURRENT_ATOM_SET
+			found[i] = s._atoms.insert(atoms[i]);
+#else
+			auto pr = s._atoms.insert(atoms[i]);
+			if (not pr.second) found[i] = *pr.first;
+#endif
+			if (nullptr == found[i]) shard[i]->count(s, atoms[i], 1);
+		}
+	};
+
+	// The filter that the batch goes into, if any; see noted(). If
+	// grow() replaces it, the guard holds it until the next retire.
+	// The guard is let go of before growing.
+	bool full = false;
+	{
+		EpochGuard guard;
+		AtomFilter* f = _filter.load();
+		for (const Handle& h : atoms)
+			if (note(f, h)) full = true;
+
+		// Different stripes don't share anything; fill them in parallel.
+		parallel_for(runs.size() - 1, fill, 1);
+
+		for (size_t i = 0; i < atoms.size(); i++)
+			if (nullptr == found[i]) noted(atoms[i], f);
+	}
+	if (full) grow();
+}
+
+/// Swap the full filter for one that is sized to the Atoms in the
+/// index. If that is no bigger, then the filter was filled up by Atoms
+/// that have since been removed; the new one is the same size, but
+/// has only the Atoms still here. Either way, the filter has to fill
+/// up all over again before the next swap, so the cost of the swap is
+/// spread over about as many inserts as there are Atoms.
+///
+/// The new filter covers the index while it is filled, so that Atoms
+/// added in the meantime are not missed; see noted() for the ones
+/// that went into the old filter just before the swap.
+void TypeIndex::grow(void)
+{
+	std::unique_lock<std::mutex> lck(_grow_mtx, std::try_to_lock);
+	if (not lck.owns_lock()) return;
+
+	// Someone else just did it.
+	if (not _filter.load()->full()) return;
+
+	size_t natoms = size();
+	size_t nbits = TYPE_INDEX_FILTER_BITS;
+	while (nbits < 16 * natoms and nbits < (1UL << 30))
+		nbits *= 2;
+
+	AtomFilter* fresh = new AtomFilter(nbits);
+	cover(fresh);
+	for_each(ATOM, true, [&](const Handle& h) { fresh->insert(h); });
+	AtomFilter* old = _filter.exchange(fresh);
+	uncover(fresh);
+	Epoch::retire(old);
+}
+
+void TypeIndex::cover(AtomFilter* f)
+{
+	std::unique_lock<std::shared_mutex> lck(_cover_mtx);
+	_covers.push_back(f);
+	_covered = true;
+}
+
+void TypeIndex::uncover(AtomFilter* f)
+{
+	std::unique_lock<std::shared_mutex> lck(_cover_mtx);
+	auto it = std::find(_covers.begin(), _covers.end(), f);
+	if (_covers.end() != it) _covers.erase(it);
+	_covered = not _covers.empty();
 }
 
 void TypeIndex::clear(void)
 {
-	std::vector<AtomSet> dead;
+	// Start over with a small filter, rather than keeping a big one,
+	// that might only fill up again with Atoms that come and go.
+	if (nullptr != _filter.load())
+	{
+		std::lock_guard<std::mutex> lck(_grow_mtx);
+		Epoch::retire(_filter.exchange(new AtomFilter(TYPE_INDEX_FILTER_BITS)));
+	}
+
+	HandleSeq dead;
+	for (TypeShard& ts : _idx)
 	{
-		TYPE_INDEX_UNIQUE_LOCK;
-		dead.resize(_num_types + 1);
-		dead.swap(_idx);
+		AtomStripe* s = ts.stripes();
+		if (nullptr == s) continue;
+		for (size_t i = 0; i < ts.num_stripes(); i++)
+		{
+			STRIPE_UNIQUE_LOCK(s[i]);
+			if (s[i]._atoms.empty()) continue;
 
-		// Clear the AtomSpace before releasing the lock.
-		for (auto& s : dead)
-			for (auto& h : s)
+			// Clear the AtomSpace before releasing the lock.
+			for (const Handle& h : s[i]._atoms)
+			{
+				ts.count(s[i], h, -1);
 				h->_atom_space = nullptr;
+				dead.push_back(h);
+			}
+			s[i]._atoms.clear();
+		}
 	}
 
 	// Do the final cleanup after releasing the lock. This enables
@@ -58,16 +227,42 @@ void TypeIndex::clear(void)
 	// in the `AtomSpace::add()` method. We do it here cause its
 	// easier. Anyway, we can't do the `remove()` under the lock,
 	// that would result in lock inversion.
-	for (auto& s : dead)
-	{
-		for (auto& h : s)
-			h->remove();
-		s.clear();
-	}
+	for (const Handle& h : dead)
+		h->remove();
 }
 
 // ================================================================
 
+void TypeIndex::for_each(Type type, bool subclass,
+                         const std::function<void(const Handle&)>& fn) const
+{
+	for (Type t = type; t<_num_types; t++)
+	{
+		if (t != type and (not subclass or not _nameserver.isA(t, type)))
+			continue;
+
+		const TypeShard& ts(_idx.at(t));
+		AtomStripe* s = ts.stripes();
+		if (nullptr == s) continue;
+		for (size_t i = 0; i < ts.num_stripes(); i++)
+		{
+#if USE_CONCURRENT_ATOM_SET
+			s[i]._atoms.for_each(fn);
+#else
+			// Copy one stripe at a time, and release the lock before
+			// calling back; the callback might want to add Atoms.
+			HandleSeq chunk;
+			{
+				STRIPE_SHARED_LOCK(s[i]);
+				chunk.assign(s[i]._atoms.begin(), s[i]._atoms.end());
+			}
+			for (const Handle& h : chunk)
+				fn(h);
+#endif
+		}
+	}
+}
+
 void TypeIndex::get_handles_by_type(HandleSeq& hseq,
                                     Type type,
                                     bool subclass) const
@@ -83,10 +278,11 @@ void TypeIndex::get_handles_by_type(HandleSeq& hseq,
 	// allocations and copies whenever the allocated size is exceeded.
 	hseq.reserve(initial_size + size_of_append);
 
-	TYPE_INDEX_SHARED_LOCK;
-	const AtomSet& s(_idx.at(type));
-	for (const Handle& h : s)
-		hseq.push_back(h);
+	auto append = [&](const AtomSet& s) {
+		for (const Handle& h : s)
+			hseq.push_back(h);
+	};
+	foreach_stripe(type, append);
 
 	// Not subclassing? We are done!
 	if (not subclass) return;
@@ -94,10 +290,7 @@ void TypeIndex::get_handles_by_type(HandleSeq& hseq,
 	for (Type t = type+1; t<_num_types; t++)
 	{
 		if (not _nameserver.isA(t, type)) continue;
-
-		const AtomSet& s(_idx.at(t));
-		for (const Handle& h : s)
-			hseq.push_back(h);
+		foreach_stripe(t, append);
 	}
 }
 
@@ -106,9 +299,10 @@ void TypeIndex::get_handles_by_type(UnorderedHandleSet& hset,
                                     Type type,
                                     bool subclass) const
 {
-	TYPE_INDEX_SHARED_LOCK;
-	const AtomSet& s(_idx.at(type));
-	hset.insert(s.begin(), s.end());
+	auto append = [&](const AtomSet& s) {
+		hset.insert(s.begin(), s.end());
+	};
+	foreach_stripe(type, append);
 
 	// Not subclassing? We are done!
 	if (not subclass) return;
@@ -116,9 +310,7 @@ void TypeIndex::get_handles_by_type(UnorderedHandleSet& hset,
 	for (Type t = type+1; t<_num_types; t++)
 	{
 		if (not _nameserver.isA(t, type)) continue;
-
-		const AtomSet& s(_idx.at(t));
-	   hset.insert(s.begin(), s.end());
+		foreach_stripe(t, append);
 	}
 }
 
@@ -140,13 +332,12 @@ void TypeIndex::get_rootset_by_type(HandleSeq& hseq,
 	// allocations and copies whenever the allocated size is exceeded.
 	hseq.reserve(initial_size + size_of_append);
 
-	TYPE_INDEX_SHARED_LOCK;
-	const AtomSet& s(_idx.at(type));
-	for (const Handle& h : s)
-	{
-		if (h->isIncomingSetEmpty(cas))
-			hseq.push_back(h);
-	}
+	auto append = [&](const AtomSet& s) {
+		for (const Handle& h : s)
+			if (h->isIncomingSetEmpty(cas))
+				hseq.push_back(h);
+	};
+	foreach_stripe(type, append);
 
 	// Not subclassing? We are done!
 	if (not subclass) return;
@@ -154,11 +345,7 @@ void TypeIndex::get_rootset_by_type(HandleSeq& hseq,
 	for (Type t = type+1; t<_num_types; t++)
 	{
 		if (not _nameserver.isA(t, type)) continue;
-
-		const AtomSet& s(_idx.at(t));
-		for (const Handle& h : s)
-			if (h->isIncomingSetEmpty(cas))
-				hseq.push_back(h);
+		foreach_stripe(t, append);
 	}
 }
 
@@ -22,18 +22,25 @@
 #ifndef _OPENCOG_TYPEINDEX_H
 #define _OPENCOG_TYPEINDEX_H
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #if HAVE_FOLLY
 #include <folly/container/F14Set.h>
 #else
-#include <set>
+#include <unordered_set>
 #endif
 
 #include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Epoch.h>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/atom_types/types.h>
+#include <opencog/atomspace/ConcurrentAtomSet.h>
 
 namespace opencog
 {
@@ -51,85 +58,523 @@ namespace opencog
 //    sometimes reports the same result twice. Why? I dunno. This
 //    one failure is enough to say "not recommended." I don't need
 //    to be chasing obscure bugs.
-#if HAVE_FOLLY_XXX
+//
+// The ConcurrentAtomSet is an open-addressing hash table that can be
+// searched without taking any locks; this allows findAtom() to run
+// without ever waiting on, or blocking, concurrent inserts. Writers
+// still serialize on the stripe locks below. Comment out the define
+// to go back to std::unordered_set, with a locked findAtom().
+#define USE_CONCURRENT_ATOM_SET 1
+
+#if USE_CONCURRENT_ATOM_SET
+typedef ConcurrentAtomSet AtomSet;
+#elif HAVE_FOLLY_XXX
 typedef folly::F14ValueSet<Handle> AtomSet;
 #else
 typedef std::unordered_set<Handle> AtomSet;
 #endif
 
-#define TYPE_INDEX_SHARED_LOCK std::shared_lock<std::shared_mutex> lck(_mtx);
+// The number of hash-striped sub-shards used for each of the "hot"
+// types, i.e. the handful of types that hold most of the Atoms in
+// large datasets (ListLink, EvaluationLink, ConceptNode, and so on).
+// Each stripe has it's own lock, so that threads inserting Atoms of
+// the same type do not have to wait for one-another, most of the time.
+// All other types get a single stripe, i.e. a lock-per-type.  Setting
+// this to 1 gives plain per-type locking. Must be a power of two.
+#define TYPE_INDEX_STRIPES 16
+
+// The number of arity buckets counted for each type: links of arity
+// 0 through TYPE_INDEX_ARITIES-2 each get their own count, and all the
+// longer ones share the last. Nodes are counted as arity zero. The
+// query planner uses these counts to size up the clauses of a search.
+#define TYPE_INDEX_ARITIES 8
+
+// The number of bits that the Bloom filter, that the index of each
+// frame keeps over the Atoms in it, starts out with; see AtomFilter and
+// TypeIndex::use_filter(). Frames rarely
+// hold more than a few hundred Atoms; for those, a lookup of an Atom
+// that is not there is almost always turned away without touching the
+// index itself. Bigger ones get a bigger filter, as they fill up; see
+// TypeIndex::grow(). Must be a power of two.
+#define TYPE_INDEX_FILTER_BITS 4096
+
 #define TYPE_INDEX_UNIQUE_LOCK std::unique_lock<std::shared_mutex> lck(_mtx);
+#define STRIPE_SHARED_LOCK(S) std::shared_lock<std::shared_mutex> lck((S)._mtx);
+#define STRIPE_UNIQUE_LOCK(S) std::unique_lock<std::shared_mutex> lck((S)._mtx);
+
+/**
+ * A hash table of Atoms, together with the lock that guards it.
+ * Aligned to a cache line, so that neighboring stripes do not
+ * bounce the same cache line between CPU cores (false sharing).
+ */
+struct alignas(64) AtomStripe
+{
+	mutable std::shared_mutex _mtx;
+	AtomSet _atoms;
+
+	// How many Atoms of each arity are in this stripe. Changed only
+	// under the lock, whose cache line is already at hand; read
+	// without it, and summed over the stripes, by TypeShard.
+	std::atomic<size_t> _arity[TYPE_INDEX_ARITIES];
+
+	// Bumped every time an Atom in this stripe is inserted, removed,
+	// hidden or un-hidden; see TypeShard::stamp().
+	std::atomic<size_t> _stamp;
+
+	AtomStripe(void) : _stamp(0) { for (auto& a : _arity) a = 0; }
+};
+
+/**
+ * All of the Atoms of a single Type, split into one or more stripes.
+ * The stripe that an Atom lives in is determined by the Atom hash.
+ *
+ * The stripes are not allocated until the first Atom of that Type is
+ * inserted. A typical AtomSpace holds only a few dozen different
+ * Types, and so this keeps empty and nearly-empty AtomSpaces (e.g.
+ * transient spaces, and Frames) small.
+ */
+class TypeShard
+{
+	private:
+		std::atomic<AtomStripe*> _stripes;
+		size_t _nstripes;
+
+		AtomStripe* alloc(void);
+
+		size_t index(const Handle& h) const
+		{
+			// The AtomSet hash buckets use the low bits of the hash;
+			// mix it up and use the high bits here, instead.
+			return ((h->get_hash() * 0x9e3779b97f4a7c15ULL) >> 32)
+				& (_nstripes - 1);
+		}
+
+	public:
+		TypeShard(size_t nstripes = 1) :
+			_stripes(nullptr), _nstripes(nstripes)
+		{}
+		TypeShard(TypeShard&& other) noexcept :
+			_stripes(other._stripes.exchange(nullptr)),
+			_nstripes(other._nstripes)
+		{}
+		TypeShard(const TypeShard&) = delete;
+		TypeShard& operator=(const TypeShard&) = delete;
+		~TypeShard() { delete[] _stripes.load(); }
+
+		size_t num_stripes(void) const { return _nstripes; }
+
+		static size_t bucket(const Handle& h)
+		{
+			if (not h->is_link()) return 0;
+			return std::min<size_t>(h->get_arity(), TYPE_INDEX_ARITIES-1);
+		}
+
+		/// Adjust the count for the arity of `h`, by `delta`. The
+		/// caller must hold the lock on `s`, the stripe of `h`.
+		void count(AtomStripe& s, const Handle& h, int delta)
+		{
+			std::atomic<size_t>& a(s._arity[bucket(h)]);
+			a.store(a.load(std::memory_order_relaxed) + delta,
+			        std::memory_order_relaxed);
+			touch(s);
+		}
+
+		/// Bump the stamp of stripe `s`. This is not done under the
+		/// lock, when hiding Atoms; so it is an atomic add, but on the
+		/// stripe's own cache line.
+		static void touch(AtomStripe& s)
+		{
+			s._stamp.fetch_add(1, std::memory_order_release);
+		}
+
+		/// A number that changes whenever an Atom of this Type is
+		/// inserted, removed, hidden or un-hidden: the sum of the
+		/// stripe stamps. These only ever go up, so the sum does,
+		/// too. Anything computed from the Atoms of this Type is
+		/// stale, if this has changed since.
+		size_t stamp(void) const
+		{
+			const AtomStripe* s = stripes();
+			if (nullptr == s) return 0;
+			size_t sum = 0;
+			for (size_t i = 0; i < _nstripes; i++)
+				sum += s[i]._stamp.load(std::memory_order_acquire);
+			return sum;
+		}
+
+		/// The number of Atoms with the given arity, or, for the
+		/// last bucket, with that arity or more.
+		size_t count(size_t bucket) const
+		{
+			const AtomStripe* s = stripes();
+			if (nullptr == s) return 0;
+			size_t cnt = 0;
+			for (size_t i = 0; i < _nstripes; i++)
+				cnt += s[i]._arity[bucket].load(std::memory_order_relaxed);
+			return cnt;
+		}
+
+		size_t count(void) const
+		{
+			const AtomStripe* s = stripes();
+			if (nullptr == s) return 0;
+			size_t cnt = 0;
+			for (size_t i = 0; i < _nstripes; i++)
+				for (const auto& a : s[i]._arity)
+					cnt += a.load(std::memory_order_relaxed);
+			return cnt;
+		}
+
+		/// Return the array of stripes, or nullptr if no Atom of this
+		/// Type was ever inserted.
+		AtomStripe* stripes(void) const
+		{
+			return _stripes.load(std::memory_order_acquire);
+		}
+
+		/// Return the stripe that would hold the Atom, or nullptr, if
+		/// there are no stripes.
+		AtomStripe* find_stripe(const Handle& h) const
+		{
+			AtomStripe* s = stripes();
+			if (nullptr == s) return nullptr;
+			return &s[index(h)];
+		}
+
+		/// Return the stripe that would hold the Atom, allocating the
+		/// stripes, if needed.
+		AtomStripe& get_stripe(const Handle& h)
+		{
+			AtomStripe* s = stripes();
+			if (nullptr == s) s = alloc();
+			return s[index(h)];
+		}
+};
+
+/**
+ * A Bloom filter over Atom hashes. It can say that an Atom is surely
+ * not in some set of Atoms, but not that it surely is. Bits are only
+ * ever set: an Atom that is removed from the set stays in the filter,
+ * until it is cleared. Both insert() and may_contain() are lock-free.
+ */
+class AtomFilter
+{
+	private:
+		std::unique_ptr<std::atomic<uint64_t>[]> _words;
+		size_t _mask;
+
+		// A word with more bits set than this is crowded; if they all
+		// were, about one miss in twenty would get past the filter.
+		static constexpr int crowded = 24;
+
+		// How many words have gotten crowded, and how many may be,
+		// before the filter counts as full. Each word is counted once,
+		// by the insert that crowds it, so this is seldom written.
+		std::atomic<size_t> _ncrowded;
+		size_t _most;
+
+		// Three probes, by double hashing; the Atom hash is already
+		// well-mixed, the multiplies spread it over the high bits too.
+		template<typename FN>
+		void probe(const Handle& h, FN fn) const
+		{
+			uint64_t a = h->get_hash() * 0x9e3779b97f4a7c15ULL;
+			uint64_t b = ((a >> 32) | (a << 32)) * 0xc2b2ae3d27d4eb4fULL | 1;
+			for (int i = 0; i < 3; i++, a += b)
+			{
+				size_t bit = (a >> 7) & _mask;
+				fn(_words[bit >> 6], 1ULL << (bit & 63));
+			}
+		}
+
+	public:
+		/// The number of bits must be a power of two, at least 64.
+		AtomFilter(size_t nbits) :
+			_words(new std::atomic<uint64_t>[nbits / 64]),
+			_mask(nbits - 1),
+			_most(std::max<size_t>(1, nbits / 4096))
+		{
+			clear();
+		}
+
+		/// Return true if the filter is full: if the Atom crowded one
+		/// of the words that it went into, and too many already were.
+		bool insert(const Handle& h)
+		{
+			bool full = false;
+			probe(h, [&](std::atomic<uint64_t>& w, uint64_t m)
+			{
+				// Atoms added again, and most of the bits of a filter
+				// that is filling up, are set already; don't take the
+				// cache line away from the other inserters, for those.
+				if (w.load(std::memory_order_acquire) & m) return;
+				uint64_t old = w.fetch_or(m, std::memory_order_release);
+				if (old & m) return;
+				if (crowded == __builtin_popcountll(old))
+					full = _most <= 1 + _ncrowded.fetch_add(1) or full;
+			});
+			return full;
+		}
+
+		bool full(void) const { return _most <= _ncrowded.load(); }
+
+		bool may_contain(const Handle& h) const
+		{
+			bool yes = true;
+			probe(h, [&](const std::atomic<uint64_t>& w, uint64_t m)
+				{ yes = yes and (w.load(std::memory_order_acquire) & m); });
+			return yes;
+		}
+
+		void clear(void)
+		{
+			for (size_t i = 0; i <= _mask / 64; i++)
+				_words[i].store(0, std::memory_order_relaxed);
+			_ncrowded = 0;
+		}
+
+		size_t nbits(void) const { return _mask + 1; }
+};
 
 /**
  * Implements a vector of AtomSets; each AtomSet is a hash table of
  * Atom pointers.  Thus, given an Atom Type, this can quickly find
  * all of the Atoms of that Type.
  *
- * The primary interface for this is an iterator, and that is because
- * the index will typically contain millions of atoms, and this is far
- * too much to try to copy into some temporary array.  Iterating is much
- * faster.
+ * The index is sharded: each Type has it's own lock, and the most
+ * heavily-used Types are further split into several hash-striped
+ * sub-shards, each with it's own lock. Thus, threads that add or
+ * remove Atoms of different Types (or Atoms that hash to different
+ * stripes) do not contend with one-another. There is no global lock;
+ * the only price paid is that a walk over the index (to get all Atoms
+ * of some Type) is no longer an atomic snapshot across all stripes.
+ * With USE_CONCURRENT_ATOM_SET, lookups don't take any lock at all.
  *
- * @todo The iterator is NOT thread-safe against the insertion or
- * removal of atoms!  Either inserting or removing an atom will cause
- * the iterator references to be freed, leading to mystery crashes!
+ * The index will typically contain millions of atoms, and this is far
+ * too much to try to copy into some temporary array. The for_each()
+ * method walks the index without copying it, and (with
+ * USE_CONCURRENT_ATOM_SET) without taking any locks; writers are
+ * not blocked while the walk is in progress. Atoms added or removed
+ * during the walk may or may not be seen; all others are seen once.
  */
 class TypeIndex
 {
 	private:
-		std::vector<AtomSet> _idx;
+		std::vector<TypeShard> _idx;
 		size_t _num_types;
 		NameServer& _nameserver;
 
-		// Single, global mutex for locking the index.
+		// Guards the resizing of the index, only. Everything else is
+		// guarded by the per-stripe locks.
 		mutable std::shared_mutex _mtx;
+
+		size_t num_stripes(Type) const;
+
+		// A filter over all of the Atoms ever inserted here, if asked
+		// for, and the filters of others that cover this index too;
+		// each insert is noted in all of them. The flag saves taking
+		// the lock, for the usual case of there being none of the
+		// others. The filter is swapped for a new one when it fills
+		// up, or is cleared; the old one is retired, so it must be
+		// looked at inside an EpochGuard. Without a filter, there is
+		// no need for the guard.
+		std::atomic<AtomFilter*> _filter;
+		std::mutex _grow_mtx;
+		mutable std::shared_mutex _cover_mtx;
+		std::vector<AtomFilter*> _covers;
+		std::atomic<bool> _covered;
+
+		// Called before the Atom is in the index, with the current
+		// filter, if any: a lookup that could find the Atom there must
+		// not be turned away by a filter. Returns true if the filter
+		// is full.
+		bool note(AtomFilter* f, const Handle& h)
+		{
+			bool full = f and f->insert(h);
+			note_covers(h);
+			return full;
+		}
+
+		// Called again after the Atom is in the index, so that cover()
+		// either sees the Atom, or has been seen here; and likewise
+		// for a new filter, swapped in by grow() in the meantime.
+		void noted(const Handle& h, const AtomFilter* f)
+		{
+			if (f)
+			{
+				AtomFilter* now = _filter.load();
+				if (now != f) now->insert(h);
+			}
+			note_covers(h);
+		}
+
+		void note_covers(const Handle& h)
+		{
+			if (not _covered.load()) return;
+			std::shared_lock<std::shared_mutex> lck(_cover_mtx);
+			for (AtomFilter* f : _covers)
+				f->insert(h);
+		}
+
+		void grow(void);
+
+		// Insert the Atom, noting it in `f`, if there is one; `full`
+		// is set if `f` is full.
+		Handle insert(const Handle& h, AtomFilter* f, bool& full)
+		{
+			TypeShard& ts(_idx.at(h->get_type()));
+			AtomStripe& s(ts.get_stripe(h));
+			full = note(f, h);
+			STRIPE_UNIQUE_LOCK(s);
+#if USE_CONCURRENT_ATOM_SET
+			Handle old(s._atoms.insert(h));
+			if (nullptr != old) return old;
+#else
+			auto iter = s._atoms.find(h);
+			if (s._atoms.end() != iter) return *iter;
+			s._atoms.insert(h);
+#endif
+			ts.count(s, h, 1);
+			lck.unlock();
+			noted(h, f);
+			return Handle::UNDEFINED;
+		}
+
+		// Call `fn` on the AtomSet in each stripe of type `t`, while
+		// holding that stripe's shared lock.
+		template<typename FN>
+		void foreach_stripe(Type t, FN fn) const
+		{
+			const TypeShard& ts(_idx.at(t));
+			AtomStripe* s = ts.stripes();
+			if (nullptr == s) return;
+			for (size_t i = 0; i < ts.num_stripes(); i++)
+			{
+				STRIPE_SHARED_LOCK(s[i]);
+				fn(s[i]._atoms);
+			}
+		}
+
 	public:
 		TypeIndex(void);
+		~TypeIndex();
 		void resize(void);
 
+		// Keep a filter over the Atoms inserted here, for may_contain().
+		// It lets lookups from the frames above skip over this one; it
+		// is of no use to a space that has nothing under it, to skip
+		// to. Must be called before anything is inserted.
+		void use_filter(void);
+
 		// Return a Handle, if it's already in the set.
 		// Else, return nullptr
 		Handle insertAtom(const Handle& h)
 		{
-			AtomSet& s(_idx.at(h->get_type()));
-			TYPE_INDEX_UNIQUE_LOCK;
-			auto iter = s.find(h);
-			if (s.end() != iter) return *iter;
-			s.insert(h);
-			return Handle::UNDEFINED;
+			bool full;
+			if (nullptr == _filter.load(std::memory_order_relaxed))
+				return insert(h, nullptr, full);
+
+			Handle old;
+			{
+				EpochGuard guard;
+				old = insert(h, _filter.load(), full);
+			}
+			if (full) grow();
+			return old;
 		}
 
+		// Insert a batch of Atoms, taking each stripe lock just once,
+		// and growing each stripe just once. On return, `found[i]` is
+		// the Atom that was already in the index, if `atoms[i]` was a
+		// duplicate, else Handle::UNDEFINED.
+		void insertAtoms(const HandleSeq& atoms, HandleSeq& found);
+
 		bool removeAtom(const Handle& h)
 		{
-			AtomSet& s(_idx.at(h->get_type()));
-			TYPE_INDEX_UNIQUE_LOCK;
-			return 1 == s.erase(h);
+			TypeShard& ts(_idx.at(h->get_type()));
+			AtomStripe* s = ts.find_stripe(h);
+			if (nullptr == s) return false;
+			STRIPE_UNIQUE_LOCK(*s);
+			if (1 != s->_atoms.erase(h)) return false;
+			ts.count(*s, h, -1);
+			return true;
 		}
 
 		Handle findAtom(const Handle& h) const
 		{
-			const AtomSet& s(_idx.at(h->get_type()));
-			TYPE_INDEX_SHARED_LOCK;
-			auto iter = s.find(h);
-			if (s.end() == iter) return Handle::UNDEFINED;
+			const AtomStripe* s = _idx.at(h->get_type()).find_stripe(h);
+			if (nullptr == s) return Handle::UNDEFINED;
+#if USE_CONCURRENT_ATOM_SET
+			// Lock-free.
+			return s->_atoms.find(h);
+#else
+			STRIPE_SHARED_LOCK(*s);
+			auto iter = s->_atoms.find(h);
+			if (s->_atoms.end() == iter) return Handle::UNDEFINED;
 			return *iter;
+#endif
 		}
 
+		// Return false if the Atom was never inserted here, since the
+		// last clear(); true if it might have been, or if there is no
+		// filter.
+		bool may_contain(const Handle& h) const
+		{
+			if (nullptr == _filter.load(std::memory_order_relaxed))
+				return true;
+			EpochGuard guard;
+			return _filter.load()->may_contain(h);
+		}
+
+		/// The size of the filter, in bits; zero if there is none.
+		size_t filter_bits(void) const
+		{
+			if (nullptr == _filter.load(std::memory_order_relaxed))
+				return 0;
+			EpochGuard guard;
+			return _filter.load()->nbits();
+		}
+
+		// Note all inserts in the filter, too, from now on; and until
+		// uncover(). The filter must be filled with the Atoms already
+		// here by the caller, after this returns.
+		void cover(AtomFilter*);
+		void uncover(AtomFilter*);
+
 		// How many atoms are there of type t?
 		size_t size(Type t) const
 		{
-			const AtomSet& s(_idx.at(t));
-			TYPE_INDEX_SHARED_LOCK;
-			return s.size();
+			return _idx.at(t).count();
+		}
+
+		// How many atoms of type t, with arity a? Arities past the
+		// last bucket are all counted together; asking for any of
+		// them gets the count of all of them.
+		size_t size_by_arity(Type t, Arity a) const
+		{
+			return _idx.at(t).count(std::min<size_t>(a, TYPE_INDEX_ARITIES-1));
+		}
+
+		// A number that changes whenever an atom of type t is added,
+		// removed, hidden or un-hidden.
+		size_t stamp(Type t) const
+		{
+			return _idx.at(t).stamp();
+		}
+
+		// Record that the atom has changed, without it being added or
+		// removed. Used when hiding atoms in frames.
+		void touch(const Handle& h)
+		{
+			TypeShard::touch(_idx.at(h->get_type()).get_stripe(h));
 		}
 
 		// How many atoms, grand total?
 		size_t size(void) const
 		{
 			size_t cnt = 0;
-			TYPE_INDEX_SHARED_LOCK;
-			for (const auto& s : _idx)
-				cnt += s.size();
+			for (Type t = 0; t < _idx.size(); t++)
+				cnt += size(t);
 			return cnt;
 		}
 
@@ -149,6 +594,9 @@ class TypeIndex
 
 		void clear(void);
 
+		void for_each(Type, bool subclass,
+		              const std::function<void(const Handle&)>&) const;
+
 		void get_handles_by_type(HandleSeq&, Type, bool subclass) const;
 		void get_handles_by_type(UnorderedHandleSet&, Type, bool subclass) const;
 		void get_rootset_by_type(HandleSeq&, Type, bool subclass,
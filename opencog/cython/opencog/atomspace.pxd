@@ -243,7 +243,7 @@ cdef extern from "opencog/atoms/value/FloatValue.h" namespace "opencog":
     cdef cppclass cFloatValue "opencog::FloatValue":
         cFloatValue(double value)
         cFloatValue(const vector[double]& values)
-        const vector[double]& value() const
+        vector[double] value() const
 
 
 # StringValue
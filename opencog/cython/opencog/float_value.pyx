@@ -10,8 +10,9 @@ def createFloatValue(arg):
 cdef class FloatValue(Value):
 
     def to_list(self):
-        return FloatValue.vector_of_doubles_to_list(
-            &((<cFloatValue*>self.get_c_value_ptr().get()).value()))
+        cdef vector[double] nums = \
+            (<cFloatValue*>self.get_c_value_ptr().get()).value()
+        return FloatValue.vector_of_doubles_to_list(&nums)
 
     @staticmethod
     cdef vector[double] list_of_doubles_to_vector(list python_list):
@@ -22,6 +22,7 @@
 #include <opencog/util/exceptions.h>
 #include <opencog/util/Logger.h>
 
+#include <opencog/atoms/core/FindUtils.h>
 #include <opencog/atoms/core/Replacement.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
 
@@ -54,6 +55,21 @@ public:
 
 /* ======================================================== */
 
+bool ContinuationMixin::have_continuation(void) const
+{
+	// The components of a disconnected pattern have no body; just
+	// clauses. Continuations are evaluatable, and so are mandatory.
+	if (_pattern->body)
+		return contains_atomtype(_pattern->body, CONTINUATION_LINK);
+
+	for (const PatternTermPtr& ptm : _pattern->pmandatory)
+		if (contains_atomtype(ptm->getHandle(), CONTINUATION_LINK))
+			return true;
+	return false;
+}
+
+/* ======================================================== */
+
 /**
  */
 bool ContinuationMixin::evaluate_sentence(const Handle& top,
@@ -68,6 +68,11 @@ class ContinuationMixin :
 
 	protected:
 		Handle _continuation;
+
+		/// True if the pattern has a ContinuationLink in it. These
+		/// unwind the stack of the thread that hits them, and so the
+		/// search cannot be split across threads.
+		bool have_continuation(void) const;
 };
 
 } // namespace opencog
@@ -24,6 +24,8 @@
 #ifndef _OPENCOG_IMPLICATOR_H
 #define _OPENCOG_IMPLICATOR_H
 
+#include <typeinfo>
+
 #include "InitiateSearchMixin.h"
 #include "RewriteMixin.h"
 #include "SatisfyMixin.h"
@@ -56,6 +58,25 @@ class Implicator:
 				RewriteMixin::set_plp(plp);
 				return SatisfyMixin::satisfy(plp);
 			}
+
+			// The memo holds groundings made by the default matching
+			// callbacks; a subclass with other callbacks may not agree
+			// with them. As with the parallel search, below, only
+			// Implicator itself uses it.
+			virtual GroundingMemo* get_grounding_memo(void)
+			{
+				if (typeid(*this) != typeid(Implicator)) return nullptr;
+				return default_memo();
+			}
+
+	protected:
+		// The threads of a parallel search match with the callbacks
+		// of TermMatchMixin, not with any overrides of them. Thus,
+		// only Implicator itself searches in parallel; a subclass
+		// that keeps the default matching callbacks may opt in by
+		// overriding this.
+		virtual bool can_search_in_parallel(void) const
+		{ return typeid(*this) == typeid(Implicator); }
 };
 
 }; // namespace opencog
@@ -21,8 +21,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include <opencog/atomspace/AtomSpace.h>
 
+#include <opencog/atoms/base/WorkerPool.h>
 #include <opencog/atoms/core/DefineLink.h>
 #include <opencog/atoms/core/LambdaLink.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
@@ -31,12 +36,7 @@
 
 #include "InitiateSearchMixin.h"
 #include "PatternMatchEngine.h"
-
-#ifdef USE_THREADED_PATTERN_ENGINE
-	// #include <algorithm>
-	// #include <execution>
-	#include <opencog/util/oc_omp.h>
-#endif // USE_THREADED_PATTERN_ENGINE
+#include "TermMatchMixin.h"
 
 using namespace opencog;
 
@@ -49,21 +49,35 @@ using namespace opencog;
 
 /* ======================================================== */
 
+// Only worth it for big searches; see search_loop(), below.
+size_t InitiateSearchMixin::parallel_threshold = 20000;
+size_t InitiateSearchMixin::parallel_threads =
+	std::thread::hardware_concurrency();
+
+bool InitiateSearchMixin::use_planner = true;
+bool InitiateSearchMixin::use_memo = true;
+
 InitiateSearchMixin::InitiateSearchMixin(AtomSpace* as) :
 	_nameserver(nameserver())
 {
 	_variables = nullptr;
 	_pattern = nullptr;
-	_recursing = false;
 
 	_root = PatternTerm::UNDEFINED;
 	_starter_term = PatternTerm::UNDEFINED;
 
 	_curr_clause = PatternTerm::UNDEFINED;
 	_start_choices.clear();
+	_explain = false;
 	_as = as;
 }
 
+GroundingMemo* InitiateSearchMixin::default_memo(void) const
+{
+	if (not use_memo or nullptr == _as) return nullptr;
+	return &_as->get_grounding_memo();
+}
+
 /* ======================================================== */
 
 // Find a good place to start the search.
@@ -344,8 +358,34 @@ bool InitiateSearchMixin::setup_neighbor_search(const PatternTermSeq& clauses)
 	// Note also: the user is allowed to specify patterns that have
 	// no constants in them at all.  In this case, the search is
 	// performed by looping over all links of the given types.
+	//
+	// The thinnest clause is not always the best place to start: if
+	// it joins to the next clauses through some very popular atoms,
+	// the search fans out right after the start. When there are enough
+	// clauses for this to matter, the planner looks at the whole
+	// pattern, and picks the start clause, and the order of the rest.
+	_plan = nullptr;
+	if (use_planner)
+	{
+		QueryPlanner planner(_as, *_variables);
+		_plan = planner.plan(clauses);
+	}
+
 	PatternTermPtr bestclause;
-	Handle best_start = find_thinnest(clauses, _starter_term, bestclause);
+	Handle best_start(Handle::UNDEFINED);
+	if (_plan)
+		best_start = find_thinnest({_plan->start()}, _starter_term, bestclause);
+	if (nullptr == best_start and 0 == _start_choices.size())
+	{
+		_plan = nullptr;
+		best_start = find_thinnest(clauses, _starter_term, bestclause);
+	}
+
+	if (_plan and _explain)
+	{
+		_plan->counting = true;
+		_plans.push_back(_plan);
+	}
 
 	// Cannot find a starting point! This can happen if:
 	// 1) all of the clauses contain nothing but variables,
@@ -506,6 +546,7 @@ bool InitiateSearchMixin::perform_search(PatternMatchCallback& pmc)
 	_curr_clause = PatternTerm::UNDEFINED;
 	_search_set.clear();
 	_start_choices.clear();
+	_plan = nullptr;
 
 	// Fallback to the legacy mode.
 	if (1 != _pattern->pmandatory.size())
@@ -1123,124 +1164,198 @@ bool InitiateSearchMixin::search_loop(PatternMatchCallback& pmc,
                                       const std::string dbg_banner)
 {
 	// This is the main entry point into the CPU-cycle sucking part of
-	// the pattern search.  If `USE_THREADED_PATTERN_ENGINE` is defined,
-	// then it runs in parallel. It works, unit-tests pass. But ...
-	// But the overhead is so large, that, for small pattern matches,
-	// the setup of going parallel is far more expensive than the gain
-	// from parallelism. (RandomUTest runs 25x slower! GetStateUTest
-	// runs 33x slower!) So this code is currently disabled.
+	// the pattern search. Large searches are split across threads;
+	// see parallel_search() below. But the overhead of going parallel
+	// is large, compared to a small pattern match. (When every search
+	// went parallel, RandomUTest ran 25x slower, and GetStateUTest ran
+	// 33x slower!) So small searches run right here, on this thread.
+	// Be careful not to penalize small users! See the benchmark
+	// `nano-en.scm` in the opencog/benchmark GitHub repo, for example.
 	//
-	// If `_search_set` is large, or the if pattern is large/complex,
-	// then the extra cost might be worth it. However, this is NOT
-	// always the bottleneck! Be careful not to penalize small users!
-	// See the benchmark `nano-en.scm` in the opencog/benchmark GitHub
-	// repo, for example.
-	//
-#ifndef USE_THREADED_PATTERN_ENGINE
-	// See explanation below for the `_recursing` flag.
-	_recursing = true;
+	// Searches started from within a parallel search (for example,
+	// by the evaluation of a clause, or by the rewrite of a grounding)
+	// also run right here: the threads are all busy already.
+	size_t hsz = _search_set.size();
+	size_t nthreads = std::min(parallel_threads, hsz);
+	size_t nclauses = _pattern->pmandatory.size() +
+		_pattern->absents.size() + _pattern->always.size();
+	if (1 < nthreads and parallel_threshold <= hsz * nclauses
+	    and not WorkerPool::busy() and can_search_in_parallel())
+		return parallel_search(pmc, nthreads);
+
+	// Plain-old, olde-fashioned sequential search loop.
+#ifdef QDEBUG
+	size_t i = 0;
 #endif
 
-	if (_recursing)
+	PatternMatchEngine pme(pmc);
+	pme.set_pattern(*_variables, *_pattern);
+
+	while (0 < _issued_stack.size()) _issued_stack.pop();
+	_issued.clear();
+	_issued.insert(_root);
+	for (const Handle& h : _search_set)
 	{
-		// Plain-old, olde-fashioned sequential search loop.
-		// This works.
-#ifdef QDEBUG
-		size_t i = 0, hsz = _search_set.size();
-#endif
+		DO_LOG({LAZY_LOG_FINE << dbg_banner
+		             << "\n       Loop candidate ("
+		             << ++i << "/" << hsz << "):\n"
+		             << h->to_string("       ");})
+		bool found = pme.explore_neighborhood(_starter_term,
+		                                      h, _root);
+		if (found) return true;
+	}
 
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
+	return false;
+}
+
+/* ======================================================== */
+
+namespace opencog {
 
-		while (0 < _issued_stack.size()) _issued_stack.pop();
-		_issued.clear();
-		_issued.insert(_root);
-		for (const Handle& h : _search_set)
+/// One thread's share of a parallel search.
+///
+/// The matching callbacks keep state: the clauses issued so far, in
+/// InitiateSearchMixin, and the bound variables and the scratch
+/// atomspace, in TermMatchMixin. So each thread gets its own copy of
+/// these, in a SearchWorker, and its own PatternMatchEngine to drive
+/// them. Only the groundings that are found go to the callback that
+/// started the search; they go one at a time, under a lock.
+///
+/// (The old threaded code shared the one callback between all of the
+/// threads. For multi-component patterns, the callback is wrapped in
+/// PMCGroundings, and is re-entered for each component, in each thread,
+/// clobbering itself.)
+class SearchWorker :
+	public InitiateSearchMixin,
+	public TermMatchMixin
+{
+	private:
+		PatternMatchCallback& _pmc;
+		std::mutex& _mtx;
+		std::atomic<bool>& _halt;
+
+	public:
+		SearchWorker(AtomSpace* as, PatternMatchCallback& pmc,
+		             std::mutex& mtx, std::atomic<bool>& halt,
+		             const PatternTermPtr& root, const QueryPlanPtr& plan) :
+			InitiateSearchMixin(as), TermMatchMixin(as),
+			_pmc(pmc), _mtx(mtx), _halt(halt)
 		{
-			DO_LOG({LAZY_LOG_FINE << dbg_banner
-			             << "\n       Loop candidate ("
-			             << ++i << "/" << hsz << "):\n"
-			             << h->to_string("       ");})
-			bool found = pme.explore_neighborhood(_starter_term,
-			                                      h, _root);
-			if (found) return true;
+			_root = root;
+			_plan = plan;
+			_issued.insert(root);
 		}
 
-		return false;
-	}
+		virtual bool propose_grounding(const GroundingMap& var_soln,
+		                               const GroundingMap& term_soln)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			if (_halt) return true;
+			if (_pmc.propose_grounding(var_soln, term_soln)) _halt = true;
+			return _halt;
+		}
 
-	// Note also: for multi-component patterns, this entire class
-	// is used recursively in multiple threads. This is because
-	// `PatternLink::satisfy()` is recursive, when there are multiple
-	// components. So: we start here, create multiple threads,
-	// and then pass ourselves into each thread. When there are
-	// components, this gets wrapped in PMCGroundings and then
-	// `PatternLink::satisfy()` is called .. once in each thread!
-	// Which causes a new start-point to be searched for, for each
-	// component which clobbers this structure against itself.  Fail.
-	// The `_recursing` flag prevents this double-threading.
-// #define PM_PARALLEL 1
-#ifdef PM_PARALLEL
-	// Parallel loop. This requires linking to -ltbb to work.
-	_recursing = true;
-
-	_issued_stack.clear();
-	_issued.clear();
-	_issued.insert(_root);
+		virtual bool propose_grouping(const GroundingMap& var_soln,
+		                              const GroundingMap& term_soln,
+		                              const GroundingMap& grouping)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			if (_halt) return true;
+			if (_pmc.propose_grouping(var_soln, term_soln, grouping))
+				_halt = true;
+			return _halt;
+		}
 
-	std::atomic<size_t> nfnd = 0;
-	std::for_each(
-		std::execution::par_unseq,
-		_search_set.begin(),
-		_search_set.end(),
-		[&](auto&& h)
+		virtual GroundingMemo* get_grounding_memo(void)
 		{
-			PatternMatchEngine pme(pmc);
-			pme.set_pattern(*_variables, *_pattern);
+			return _pmc.get_grounding_memo();
+		}
 
-			if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
-		});
+		virtual bool satisfy(const PatternLinkPtr&)
+		{
+			throw RuntimeException(TRACE_INFO,
+				"A SearchWorker only searches from a given starting point");
+		}
+};
 
-	_recursing = false;
-	return 0 < nfnd;
+} // namespace opencog
 
-#endif
+/// parallel_search() -- search_loop(), split across threads.
+///
+/// The threads take the candidates in `_search_set` in chunks, from a
+/// shared cursor, so that a thread that is stuck on a hard candidate
+/// does not hold up the others. The chunks are small enough that the
+/// load stays balanced, and large enough that the cursor is not a
+/// point of contention.
+///
+/// The callback sees the groundings in a different order than a
+/// sequential search would deliver them. Once it asks to stop, the
+/// threads all stop, and no more groundings are delivered.
+bool InitiateSearchMixin::parallel_search(PatternMatchCallback& pmc,
+                                          size_t nthreads)
+{
+	std::mutex mtx;
+	std::atomic<bool> halt(false);
+	std::atomic<bool> optionals(false);
+	std::atomic<size_t> cursor(0);
 
-#ifdef USE_THREADED_PATTERN_ENGINE
-	#define OMP_PM_PARALLEL 1
-#endif
-#ifdef OMP_PM_PARALLEL
-	// Parallel loop. This requires OpenMP to work.
-	_recursing = true;
-	_issued_stack.clear();
-	_issued.clear();
-	_issued.insert(_root);
+	size_t hsz = _search_set.size();
+	size_t chunk = std::max((size_t) 1,
+		std::min((size_t) 256, hsz / (8 * nthreads)));
 
-#ifdef QDEBUG
-	size_t i = 0;
-#endif
+	DO_LOG({LAZY_LOG_FINE << "Parallel search of " << hsz
+	             << " candidates, on " << nthreads << " threads";})
 
-	std::atomic<size_t> nfnd = 0;
-	size_t hsz = _search_set.size();
-	#pragma omp parallel for
-	for (size_t j=0; j<hsz; j++)
+	workerpool().run(nthreads, [&](size_t)
 	{
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
+		try
+		{
+			SearchWorker sw(_as, pmc, mtx, halt, _root, _plan);
+			sw.set_pattern(*_variables, *_pattern);
+			PatternMatchEngine pme(sw);
+			pme.set_pattern(*_variables, *_pattern);
 
-		Handle h(_search_set[j]);
-		DO_LOG({LAZY_LOG_FINE << dbg_banner
-		             << "\n       Loop candidate ("
-		             << ++i << "/" << hsz << "):\n"
-		             << h->to_short_string("       ");})
+			while (not halt)
+			{
+				size_t i = cursor.fetch_add(chunk);
+				if (hsz <= i) break;
+				size_t end = std::min(hsz, i + chunk);
+				for (; i < end and not halt; i++)
+					if (pme.explore_neighborhood(_starter_term,
+					                             _search_set[i], _root))
+						halt = true;
+			}
+			if (sw.optionals_present()) optionals = true;
+		}
+		catch (...)
+		{
+			// Stop the others; the pool rethrows this to our caller.
+			halt = true;
+			throw;
+		}
+	});
 
-		if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
+	// Pass on what the workers learned about the optional clauses.
+	if (optionals)
+	{
+		TermMatchMixin* tmm = dynamic_cast<TermMatchMixin*>(this);
+		if (tmm) tmm->set_optionals_present();
 	}
-	_recursing = false;
-	return 0 < nfnd;
-#endif
 
-	return false;
+	return halt;
+}
+
+/* ======================================================== */
+
+std::string InitiateSearchMixin::explain(const std::string& indent) const
+{
+	if (_plans.empty())
+		return indent + "No plans; the searches were not planned.\n";
+
+	std::stringstream ss;
+	for (const QueryPlanPtr& qp : _plans)
+		ss << qp->to_string(indent);
+	return ss.str();
 }
 
 /* ======================================================== */
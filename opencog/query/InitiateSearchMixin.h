@@ -30,6 +30,7 @@
 #include <opencog/atoms/core/Quotation.h>
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/query/PatternMatchCallback.h>
+#include <opencog/query/QueryPlanner.h>
 
 namespace opencog {
 
@@ -61,16 +62,74 @@ public:
 
 	std::string to_string(const std::string& indent=empty_string) const;
 
+	/**
+	 * Searches with at least this much work to do (the number of
+	 * starting points, times the number of clauses) are split up
+	 * across `parallel_threads` threads. Smaller searches run on the
+	 * calling thread; setting up the threads would cost more than it
+	 * saves.
+	 */
+	static size_t parallel_threshold;
+	static size_t parallel_threads;
+
+	/**
+	 * If set, searches with several clauses follow the clause order
+	 * picked by the QueryPlanner, instead of choosing the start and
+	 * the next clause greedily, as they go. On by default.
+	 */
+	static bool use_planner;
+
+	/**
+	 * If set, the Satisfier, SatisfyingSet and Implicator keep the
+	 * groundings of the cacheable clauses in the AtomSpace memo (see
+	 * `GroundingMemo`), and re-use them in later searches, until the
+	 * AtomSpace changes under them. On by default.
+	 */
+	static bool use_memo;
+
+	/**
+	 * If set, keep the plans of all of the searches done from here
+	 * on, and count the groundings that go through each step of them.
+	 * The explain() method prints them, estimates against actuals.
+	 * Counting costs a little; it is off by default.
+	 */
+	void set_explain(bool on) { _explain = on; }
+	std::string explain(const std::string& indent=empty_string) const;
+	const std::vector<QueryPlanPtr>& get_plans(void) const { return _plans; }
+
 protected:
 
 	NameServer& _nameserver;
 
-	bool _recursing;
+	/**
+	 * Return true if the search can be split across threads. The
+	 * threads do their own matching, with the matching callbacks
+	 * of TermMatchMixin, and hand the groundings to the callback,
+	 * one at a time. Thus, only callbacks that do not override the
+	 * matching callbacks should return true.
+	 */
+	virtual bool can_search_in_parallel(void) const { return false; }
+
+	/**
+	 * The AtomSpace memo, if `use_memo` is set, else nullptr. The
+	 * callbacks that do the default matching return this from
+	 * get_grounding_memo(). The memo does not know which callbacks
+	 * made the groundings in it; so, as for can_search_in_parallel(),
+	 * callbacks that override the matching callbacks must not.
+	 */
+	GroundingMemo* default_memo(void) const;
 
 	PatternTermPtr _root;
 	PatternTermPtr _starter_term;
 	HandleSeq _search_set;
 
+	// The plan for the current search, if any; and, if explaining,
+	// all of the plans so far.
+	QueryPlanPtr _plan;
+	bool _explain;
+	std::vector<QueryPlanPtr> _plans;
+	void tally_plan(void);
+
 	struct Choice
 	{
 		PatternTermPtr clause;
@@ -102,6 +161,7 @@ protected:
 	bool legacy_search(PatternMatchCallback&);
 	bool choice_loop(PatternMatchCallback&, const std::string);
 	bool search_loop(PatternMatchCallback&, const std::string);
+	bool parallel_search(PatternMatchCallback&, size_t);
 
 	static PatternTermPtr term_of_handle(const Handle&, const PatternTermPtr&);
 	static PatternTermSeq term_choices_of_handle(const Handle&, const PatternTermPtr&);
@@ -103,8 +103,21 @@ bool InitiateSearchMixin::get_next_clause(PatternTermPtr& clause,
 	return true;
 }
 
+/// Count one more grounding through the latest step of the plan. The
+/// clauses of the plan are grounded before any of the others, and
+/// so, if every issued clause is in the plan, then the one that was
+/// just grounded is the step at that depth.
+void InitiateSearchMixin::tally_plan(void)
+{
+	for (const PatternTermPtr& cl : _issued)
+		if (SIZE_MAX == _plan->rank(cl)) return;
+	_plan->tally(_issued.size() - 1);
+}
+
 void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 {
+	if (_plan and _plan->counting) tally_plan();
+
 	_choice_stack.push(_next_choices);
 	_next_choices.clear();
 
@@ -303,6 +316,12 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 	unsigned int thinnest_clause = UINT_MAX;
 	bool unsolved = false;
 
+	// If there is a plan, the next clause is the earliest one in it,
+	// out of those joined to what has been grounded so far. The plan
+	// only covers the plain mandatory clauses.
+	bool by_plan = _plan and not search_eval and not search_absents;
+	size_t earliest = SIZE_MAX;
+
 	// We are looking for a joining atom, one that is shared in common
 	// with the a fully grounded clause, and an as-yet ungrounded clause.
 	// The joint is called "pursue", and the unsolved clause that it
@@ -315,7 +334,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 		std::size_t pursue_thickness = tckvar.first;
 		const Handle& pursue = tckvar.second;
 
-		if (pursue_thickness > thinnest_joint) break;
+		if (not by_plan and pursue_thickness > thinnest_joint) break;
 
 		const auto& root_list = _pattern->connectivity_map.equal_range(pursue);
 		for (auto it = root_list.first; it != root_list.second; it++)
@@ -325,6 +344,21 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 			     and (search_eval or not root->hasAnyEvaluatable())
 			     and (search_absents or not root->isAbsent()))
 			{
+				// The joints come thinnest first; so the first one
+				// found for a clause is the one to pursue it with.
+				if (by_plan)
+				{
+					size_t rank = std::min(_plan->rank(root), SIZE_MAX-1);
+					if (rank < earliest)
+					{
+						earliest = rank;
+						unsolved_clause = root;
+						joint = pursue;
+						unsolved = true;
+					}
+					continue;
+				}
+
 				unsigned int root_thickness = thickness(root, ungrounded_vars);
 				if (root_thickness < thinnest_clause)
 				{
@@ -30,6 +30,7 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atoms/pattern/PatternTerm.h> // for pattern context
+#include <opencog/atomspace/GroundingMemo.h>
 
 namespace opencog {
 
@@ -391,6 +392,18 @@ class PatternMatchCallback
 		 */
 		virtual void pop(void) {}
 
+		/**
+		 * Return the memo in which clause groundings are kept from one
+		 * search to the next, or nullptr to not use one. The memo
+		 * holds the groundings that were accepted by the default
+		 * node_match(), link_match(), clause_match() etc. callbacks;
+		 * callbacks that match differently must not return one, else
+		 * they will get groundings that they would not have accepted.
+		 * Only the clauses that can be cached in the first place (see
+		 * `PatternLink::locate_cacheable()`) are memoized.
+		 */
+		virtual GroundingMemo* get_grounding_memo(void) { return nullptr; }
+
 		/**
 		 * Called before search initiation, to indicate the pattern
 		 * that will be searched for, and the variables to be grounded
@@ -411,8 +424,9 @@ class PatternMatchCallback
 		virtual bool satisfy(const PatternLinkPtr&) = 0;
 };
 
-// See notes in `InitiateSearchMixin.cc` for an explanation of the
-// threading code and its status.
+// Parallel searches (see `InitiateSearchMixin::parallel_search()`)
+// pass groundings to the callback one at a time, so the callbacks do
+// not need to lock. Define this to lock them anyway.
 // #define USE_THREADED_PATTERN_ENGINE
 #ifdef USE_THREADED_PATTERN_ENGINE
 	#define DECLARE_PE_MUTEX std::mutex _mtx;
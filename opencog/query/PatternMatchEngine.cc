@@ -27,6 +27,7 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atoms/core/FreeVariables.h>
 #include <opencog/atoms/core/TypeUtils.h>
 #include <opencog/atomspace/AtomSpace.h>
 
@@ -3149,36 +3150,7 @@ bool PatternMatchEngine::explore_clause(const PatternTermPtr& term,
 
 	const auto& cac = _gnd_cache.find(key);
 	if (cac != _gnd_cache.end())
-	{
-		logmsg("Cache hit!");
-
-// #ifdef QDEBUG
-#if 1 // Enable this for now, see if we hit this in the wild... (Jan 2023)
-		// Lets double-check that the term that was offered up is actually
-		// consistent with the cached grounding. There's a problem, if it
-		// is not.
-		bool check = tree_compare(term, grnd, CALL_CACHE);
-		OC_ASSERT(check, "Internal Error: term inconsistent with cache!");
-		OC_ASSERT(var_grounding.find(term->getHandle()) != var_grounding.end(),
-			"Warning: term not yet recorded!");
-		var_grounding[term->getHandle()] = grnd;
-#endif
-
-		// Record the clause grounding.
-		var_grounding[clause] = cac->second;
-
-		// Copy variable groundings, which were stored in the key.
-		// Usually, this is not needed; however, if the variable
-		// is in the outgoing set of the clause, then the grounding
-		// won't have been recorded yet, and so we have to do it here.
-		// Tested by `CacheHitUTest`.
-		const HandleSeq& clvars(_pat->clause_variables.at(pclause));
-		size_t cvsz = clvars.size();
-		for (size_t iv=0; iv<cvsz; iv++)
-			var_grounding[clvars[iv]] = key[iv+1];
-
-		return do_next_clause();
-	}
+		return cache_hit(term, grnd, pclause, key, cac->second);
 
 	// Do we have a negative cache? If so, it will always fail.
 	const auto& nac = _nack_cache.find(key);
@@ -3188,12 +3160,149 @@ bool PatternMatchEngine::explore_clause(const PatternTermPtr& term,
 		return false;
 	}
 
+	// Not seen in this search; but maybe in an earlier one. The stamp
+	// is taken before the search, so that anything that changes while
+	// searching makes the result stale.
+	HandleSeq mkey(memo_key(pclause));
+	size_t stamp = 0;
+	if (0 < mkey.size())
+	{
+		stamp = _memo->stamp(clause->get_type());
+		Handle mgnd;
+		if (_memo->lookup(mkey, stamp, mgnd))
+		{
+			logmsg("Memo hit!", mgnd);
+			if (nullptr == mgnd)
+			{
+				_nack_cache.insert(key);
+				return false;
+			}
+			_gnd_cache.insert({key, mgnd});
+			return cache_hit(term, grnd, pclause, key, mgnd);
+		}
+	}
+
 	bool okay = explore_clause_direct(term, grnd, pclause);
 	if (not okay)
 		_nack_cache.insert(key);
+
+	// The search failing, after this clause, doesn't mean that the
+	// clause could not be grounded; if it was, then it's in the
+	// positive cache by now.
+	if (0 < mkey.size())
+	{
+		const auto& acc = _gnd_cache.find(key);
+		_memo->insert(std::move(mkey), stamp,
+			acc == _gnd_cache.end() ? Handle::UNDEFINED : acc->second);
+	}
 	return okay;
 }
 
+/// Use the cached grounding `cgnd` of the clause, instead of exploring
+/// it. The `key` is the clause, followed by the groundings of the
+/// clause variables.
+bool PatternMatchEngine::cache_hit(const PatternTermPtr& term,
+                                   const Handle& grnd,
+                                   const PatternTermPtr& pclause,
+                                   const HandleSeq& key,
+                                   const Handle& cgnd)
+{
+	logmsg("Cache hit!");
+
+// #ifdef QDEBUG
+#if 1 // Enable this for now, see if we hit this in the wild... (Jan 2023)
+	// Lets double-check that the term that was offered up is actually
+	// consistent with the cached grounding. There's a problem, if it
+	// is not.
+	bool check = tree_compare(term, grnd, CALL_CACHE);
+	OC_ASSERT(check, "Internal Error: term inconsistent with cache!");
+	OC_ASSERT(var_grounding.find(term->getHandle()) != var_grounding.end(),
+		"Warning: term not yet recorded!");
+	var_grounding[term->getHandle()] = grnd;
+#endif
+
+	// Record the clause grounding.
+	var_grounding[pclause->getHandle()] = cgnd;
+
+	// Copy variable groundings, which were stored in the key.
+	// Usually, this is not needed; however, if the variable
+	// is in the outgoing set of the clause, then the grounding
+	// won't have been recorded yet, and so we have to do it here.
+	// Tested by `CacheHitUTest`.
+	const HandleSeq& clvars(_pat->clause_variables.at(pclause));
+	size_t cvsz = clvars.size();
+	for (size_t iv=0; iv<cvsz; iv++)
+		var_grounding[clvars[iv]] = key[iv+1];
+
+	return do_next_clause();
+}
+
+/// Return the memo scope and variables of the clause. Only the plain,
+/// mandatory clauses are memoized; absent and for-all clauses are
+/// accepted (or not) by different callbacks, and are left out.
+const PatternMatchEngine::MemoClause&
+PatternMatchEngine::memo_clause(const PatternTermPtr& pclause)
+{
+	const auto& it = _memo_clauses.find(pclause);
+	if (it != _memo_clauses.end()) return it->second;
+
+	MemoClause& mc(_memo_clauses[pclause]);
+	Type ct = pclause->getHandle()->get_type();
+	if (pclause->isAbsent() or pclause->isAlways() or
+	    _nameserver.isA(ct, VARIABLE_NODE) or GLOB_NODE == ct)
+		return mc;
+
+	// The variables, in an order that does not depend on their
+	// names, so that alpha-equivalent clauses get equal scopes.
+	const Handle& body(pclause->getQuote());
+	FreeVariables fv;
+	fv.find_variables(body);
+	HandleSeq decls;
+	for (const Handle& var : fv.varseq)
+	{
+		if (0 == _variables->varset.count(var)) continue;
+		mc.vars.push_back(var);
+		decls.push_back(_variables->get_type_decl(var, var));
+	}
+	if (mc.vars.size() != _pat->clause_variables.at(pclause).size())
+	{
+		mc.vars.clear();
+		return mc;
+	}
+
+	mc.scope = _memo->intern(createLink(HandleSeq{
+		createLink(std::move(decls), VARIABLE_LIST), body}, LAMBDA_LINK));
+	return mc;
+}
+
+/// Return the memo key for the clause, or the empty key, if there is
+/// no memo, or the clause is not memoized, or not all of its variables
+/// are grounded.
+HandleSeq PatternMatchEngine::memo_key(const PatternTermPtr& pclause)
+{
+	static HandleSeq empty;
+	if (nullptr == _memo) return empty;
+
+	const MemoClause& mc(memo_clause(pclause));
+	if (nullptr == mc.scope) return empty;
+
+	HandleSeq key({mc.scope});
+	for (const Handle& var : mc.vars)
+	{
+		const auto& gv = var_grounding.find(var);
+		if (var_grounding.end() == gv) return empty;
+
+		// A variable grounded by a variable of this pattern is a
+		// self-grounding; clause_match() rejects those, but another
+		// pattern, with other variables, might not.
+		Type gt = gv->second->get_type();
+		if (_nameserver.isA(gt, VARIABLE_NODE) or GLOB_NODE == gt)
+			return empty;
+		key.push_back(gv->second);
+	}
+	return key;
+}
+
 void PatternMatchEngine::record_grounding(const PatternTermPtr& ptm,
                                           const Handle& hg)
 {
@@ -3273,6 +3382,8 @@ PatternMatchEngine::PatternMatchEngine(PatternMatchCallback& pmcb)
 	_pat(nullptr),
 	clause_accepted(false)
 {
+	_memo = _pmc.get_grounding_memo();
+
 	// current state
 	depth = 0;
 
@@ -204,6 +204,24 @@ private:
 	// Positive and negative caches of clauses.
 	std::unordered_map<HandleSeq, Handle> _gnd_cache;
 	std::unordered_set<HandleSeq> _nack_cache;
+	bool cache_hit(const PatternTermPtr&, const Handle&,
+	               const PatternTermPtr&, const HandleSeq&, const Handle&);
+
+	// The AtomSpace memo, holding the caches above from one search to
+	// the next; nullptr if not in use. The key for a clause is the
+	// clause, wrapped in a LambdaLink (so that alpha-equivalent clauses
+	// share entries), followed by the groundings of the variables, in
+	// the order of the Lambda. The scope is nullptr for the clauses
+	// that are not memoized.
+	GroundingMemo* _memo;
+	struct MemoClause
+	{
+		Handle scope;
+		HandleSeq vars;
+	};
+	std::map<PatternTermPtr, MemoClause> _memo_clauses;
+	const MemoClause& memo_clause(const PatternTermPtr&);
+	HandleSeq memo_key(const PatternTermPtr&);
 
 	// -------------------------------------------
 	// Stack used to store current traversal state for a single
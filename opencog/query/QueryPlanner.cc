@@ -0,0 +1,400 @@
+/*
+ * QueryPlanner.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "QueryPlanner.h"
+
+using namespace opencog;
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+// Patterns with fewer clauses than this are left to the greedy search.
+size_t QueryPlanner::min_clauses = 3;
+
+// 2^12 subsets, times 12 clauses, is about 50K steps; a few msecs.
+size_t QueryPlanner::max_exhaustive = 12;
+
+QueryPlanner::QueryPlanner(AtomSpace* as, const Variables& vars) :
+	_as(as), _variables(vars)
+{
+}
+
+/* ======================================================== */
+// Statistics.
+
+/// The number of Atoms of type t, with arity `ar`; at least one, so
+/// that it can be divided by.
+double QueryPlanner::count(Type t, Arity ar)
+{
+	return std::max((size_t) 1, _as->get_num_atoms_of_arity(t, ar));
+}
+
+/// The number of Atoms of type t, and of all of its subtypes.
+double QueryPlanner::count(Type type)
+{
+	auto it = _type_count.find(type);
+	if (_type_count.end() != it) return it->second;
+
+	NameServer& ns = nameserver();
+	size_t n = 0;
+	for (Type t = ATOM; t < ns.getNumberOfClasses(); t++)
+	{
+		if (not ns.isA(t, type)) continue;
+		for (Arity a = 0; a < TYPE_INDEX_ARITIES; a++)
+			n += _as->get_num_atoms_of_arity(t, a);
+	}
+	double cnt = std::max((size_t) 1, n);
+	_type_count[type] = cnt;
+	return cnt;
+}
+
+/// The number of Atoms that the variable might be grounded by.
+/// Only the simple type restrictions are looked at; anything else
+/// might be anything at all.
+double QueryPlanner::domain(const Handle& var)
+{
+	auto it = _variables._typemap.find(var);
+	if (_variables._typemap.end() == it) return count(ATOM);
+
+	const TypedVariableLinkPtr& tvp(it->second);
+	TypeSet ts(tvp->get_simple_typeset());
+	if (ts.empty() or not tvp->get_deep_typeset().empty())
+		return count(ATOM);
+
+	double n = 0.0;
+	for (Type t : ts)
+		if (NOTYPE != t) n += count(t);
+	return std::max(1.0, n);
+}
+
+size_t QueryPlanner::var_index(const Handle& var)
+{
+	for (size_t i = 0; i < _vars.size(); i++)
+		if (_vars[i] == var) return i;
+	_vars.push_back(var);
+	return _vars.size() - 1;
+}
+
+/* ======================================================== */
+// Estimates.
+
+/// Collect the constants and the variables held in `ptm`, together
+/// with how much each of them narrows down the clause.
+bool QueryPlanner::walk(Clause& cl, const PatternTermPtr& ptm)
+{
+	const Handle& h = ptm->getHandle();
+	Type pt = h->get_type();
+	Arity ar = h->get_arity();
+
+	for (const PatternTermPtr& sub : ptm->getOutgoingSet())
+	{
+		if (sub->isBoundVariable())
+		{
+			size_t idx = var_index(sub->getHandle());
+			if (64 <= idx) return false;
+
+			double dom = domain(sub->getHandle());
+			Bound b;
+			b.var = idx;
+			b.sel = std::min(1.0, ar / dom);
+			b.fanout = count(pt, ar) * ar / dom;
+
+			// A variable that appears more than once is as narrow
+			// as the narrowest place it appears in.
+			cl.vars |= (1ULL << idx);
+			bool seen = false;
+			for (Bound& o : cl.bound)
+			{
+				if (o.var != idx) continue;
+				seen = true;
+				if (b.sel < o.sel) o = b;
+			}
+			if (not seen) cl.bound.push_back(b);
+			continue;
+		}
+
+		if (sub->isLink() and sub->hasAnyBoundVariable())
+		{
+			if (not walk(cl, sub)) return false;
+			continue;
+		}
+
+		// A constant. Only the links of the same type as the one it
+		// is in can be groundings; this is where the search would
+		// start, if it started here.
+		double inc = sub->getHandle()->estimateIncomingSetSizeByType(pt);
+		cl.card *= std::min(1.0, inc / count(pt, ar));
+		cl.width = std::min(cl.width, inc);
+	}
+	return true;
+}
+
+bool QueryPlanner::analyze(const PatternTermPtr& clause)
+{
+	const Handle& h = clause->getHandle();
+	if (not h->is_link()) return false;
+
+	Clause cl;
+	cl.term = clause;
+	cl.card = count(h->get_type(), h->get_arity());
+	cl.width = INF;
+	cl.vars = 0;
+	if (not walk(cl, clause)) return false;
+	_clauses.emplace_back(std::move(cl));
+	return true;
+}
+
+/// The number of groundings of the clause, for each grounding of
+/// the variables in `bound`.
+double QueryPlanner::rows(const Clause& cl, uint64_t bound) const
+{
+	double r = cl.card;
+	for (const Bound& b : cl.bound)
+		if (bound & (1ULL << b.var)) r *= b.sel;
+	return r;
+}
+
+/// The number of candidates looked at, to ground the clause, for
+/// each grounding of the variables in `bound`. The search walks the
+/// incoming set of the thinnest grounded variable.
+double QueryPlanner::probe(const Clause& cl, uint64_t bound) const
+{
+	double w = INF;
+	for (const Bound& b : cl.bound)
+		if (bound & (1ULL << b.var)) w = std::min(w, b.fanout);
+	if (INF == w) w = std::min(cl.width, cl.card);
+	return std::max(1.0, w);
+}
+
+/* ======================================================== */
+// Search over orders.
+
+/// The cheapest connected, left-deep order, by dynamic programming
+/// over the subsets of the clauses. Returns an empty order if there
+/// is no connected one.
+std::vector<size_t> QueryPlanner::exhaustive(void)
+{
+	size_t n = _clauses.size();
+	size_t nsets = 1UL << n;
+	std::vector<double> cost(nsets, INF);
+	std::vector<double> rws(nsets, 0.0);
+	std::vector<uint64_t> vmask(nsets, 0);
+	std::vector<size_t> last(nsets, 0);
+
+	for (size_t m = 1; m < nsets; m++)
+	{
+		size_t low = __builtin_ctzl(m);
+		vmask[m] = vmask[m & (m-1)] | _clauses[low].vars;
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (INF == _clauses[i].width) continue;
+		cost[1UL << i] = std::max(1.0, _clauses[i].width);
+		rws[1UL << i] = rows(_clauses[i], 0);
+		last[1UL << i] = i;
+	}
+
+	for (size_t m = 1; m < nsets; m++)
+	{
+		if (INF == cost[m]) continue;
+		for (size_t j = 0; j < n; j++)
+		{
+			size_t bit = 1UL << j;
+			if (m & bit) continue;
+			const Clause& cl(_clauses[j]);
+			if (0 == (cl.vars & vmask[m])) continue;
+
+			double c = cost[m] + rws[m] * probe(cl, vmask[m]);
+			if (c < cost[m | bit])
+			{
+				cost[m | bit] = c;
+				rws[m | bit] = rws[m] * rows(cl, vmask[m]);
+				last[m | bit] = j;
+			}
+		}
+	}
+
+	std::vector<size_t> order;
+	size_t m = nsets - 1;
+	if (INF == cost[m]) return order;
+	while (m)
+	{
+		order.push_back(last[m]);
+		m &= ~(1UL << last[m]);
+	}
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+/// Start with the thinnest clause; then, each time, take the one that
+/// is cheapest to join to what has been grounded so far.
+std::vector<size_t> QueryPlanner::greedy(void)
+{
+	size_t n = _clauses.size();
+	std::vector<size_t> order;
+	std::vector<bool> used(n, false);
+
+	size_t start = 0;
+	for (size_t i = 1; i < n; i++)
+		if (_clauses[i].width < _clauses[start].width) start = i;
+	order.push_back(start);
+	used[start] = true;
+
+	uint64_t bound = _clauses[start].vars;
+	double r = rows(_clauses[start], 0);
+	while (order.size() < n)
+	{
+		size_t best = n;
+		double best_cost = INF;
+		for (size_t j = 0; j < n; j++)
+		{
+			if (used[j] or 0 == (_clauses[j].vars & bound)) continue;
+			double c = r * probe(_clauses[j], bound);
+			if (n == best or c < best_cost) { best = j; best_cost = c; }
+		}
+
+		// Nothing is connected; take the smallest of what is left.
+		if (n == best)
+			for (size_t j = 0; j < n; j++)
+				if (not used[j] and
+				    (n == best or _clauses[j].card < _clauses[best].card))
+					best = j;
+
+		order.push_back(best);
+		used[best] = true;
+		r *= rows(_clauses[best], bound);
+		bound |= _clauses[best].vars;
+	}
+	return order;
+}
+
+/* ======================================================== */
+
+QueryPlanPtr QueryPlanner::plan(const PatternTermSeq& clauses)
+{
+	if (clauses.size() < min_clauses) return nullptr;
+
+	_clauses.clear();
+	_vars.clear();
+	bool startable = false;
+	for (const PatternTermPtr& ptm : clauses)
+	{
+		if (ptm->isChoice() or ptm->hasChoice() or ptm->isAbsent() or
+		    ptm->hasAnyGlobbyVar() or ptm->hasAnyAnonVar())
+			return nullptr;
+
+		// Evaluatables are grounded last, after all of the rest,
+		// whatever the plan says; so they are not planned.
+		if (ptm->hasAnyEvaluatable()) continue;
+		if (not ptm->hasAnyBoundVariable()) continue;
+
+		if (not analyze(ptm)) return nullptr;
+		if (INF != _clauses.back().width) startable = true;
+	}
+	if (_clauses.size() < min_clauses or not startable) return nullptr;
+
+	std::vector<size_t> order;
+	if (_clauses.size() <= max_exhaustive) order = exhaustive();
+	if (order.empty()) order = greedy();
+
+	QueryPlanPtr qp(std::make_shared<QueryPlan>());
+	uint64_t bound = 0;
+	double r = 1.0;
+	for (size_t i : order)
+	{
+		const Clause& cl(_clauses[i]);
+		QueryPlan::Step st;
+		st.clause = cl.term;
+		if (qp->_steps.empty())
+		{
+			st.width = cl.width;
+			r = rows(cl, 0);
+			qp->_cost = st.width;
+		}
+		else
+		{
+			st.width = probe(cl, bound);
+			qp->_cost += r * st.width;
+			r *= rows(cl, bound);
+		}
+		st.rows = r;
+		bound |= cl.vars;
+		qp->_steps.emplace_back(st);
+	}
+	qp->_actual = std::make_unique<std::atomic<size_t>[]>(order.size());
+	return qp;
+}
+
+/* ======================================================== */
+
+// The clause on one line, for the table.
+static std::string one_line(const Handle& h)
+{
+	std::string s(h->to_short_string());
+	std::string out;
+	bool space = false;
+	for (char c : s)
+	{
+		if (isspace(c)) { space = true; continue; }
+		if (space and not out.empty() and ')' != c) out += ' ';
+		space = false;
+		out += c;
+	}
+	return out;
+}
+
+std::string QueryPlan::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "Plan of " << _steps.size()
+	   << " clauses, estimated cost " << std::setprecision(4) << _cost
+	   << std::endl;
+	ss << indent << std::setw(4) << "step"
+	   << std::setw(12) << "width"
+	   << std::setw(12) << "est rows"
+	   << std::setw(12) << "actual"
+	   << "  clause" << std::endl;
+	for (size_t i = 0; i < _steps.size(); i++)
+	{
+		const Step& st(_steps[i]);
+		ss << indent << std::setw(4) << i
+		   << std::setw(12) << std::setprecision(4) << st.width
+		   << std::setw(12) << std::setprecision(4) << st.rows;
+		if (counting)
+			ss << std::setw(12) << actual(i);
+		else
+			ss << std::setw(12) << "-";
+		ss << "  " << one_line(st.clause->getHandle()) << std::endl;
+	}
+	return ss.str();
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,177 @@
+/*
+ * QueryPlanner.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_PLANNER_H
+#define _OPENCOG_QUERY_PLANNER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/core/Variables.h>
+#include <opencog/atoms/pattern/PatternTerm.h>
+
+namespace opencog {
+
+class AtomSpace;
+
+/**
+ * The order in which the clauses of a search are to be grounded,
+ * together with the estimated size of the search after each step.
+ *
+ * Step zero is the clause that the search starts with; its `width` is
+ * the number of starting points to be tried. Each later step is joined
+ * to the earlier ones through a shared variable; its `width` is the
+ * number of candidates to be looked at, for each grounding of the
+ * earlier steps. The `rows` is the number of partial groundings that
+ * are expected to be left after the step.
+ *
+ * If `counting` is set, then the search tallies the partial groundings
+ * that actually made it through each step, so that to_string() can
+ * show the estimates next to what really happened.
+ */
+class QueryPlan
+{
+	friend class QueryPlanner;
+public:
+	struct Step
+	{
+		PatternTermPtr clause;
+		double width;
+		double rows;
+	};
+
+private:
+	std::vector<Step> _steps;
+	double _cost;
+	std::unique_ptr<std::atomic<size_t>[]> _actual;
+
+public:
+	QueryPlan(void) : _cost(0.0), counting(false) {}
+
+	bool counting;
+
+	const std::vector<Step>& steps(void) const { return _steps; }
+	const PatternTermPtr& start(void) const { return _steps[0].clause; }
+
+	/// The estimated total work: the sum of the candidates looked at,
+	/// over all of the steps.
+	double cost(void) const { return _cost; }
+
+	/// The position of the clause in the plan, or SIZE_MAX if the
+	/// plan does not cover it (for example, if it is evaluatable).
+	size_t rank(const PatternTermPtr& clause) const
+	{
+		for (size_t i = 0; i < _steps.size(); i++)
+			if (_steps[i].clause == clause) return i;
+		return SIZE_MAX;
+	}
+
+	void tally(size_t step)
+	{
+		_actual[step].fetch_add(1, std::memory_order_relaxed);
+	}
+	size_t actual(size_t step) const { return _actual[step]; }
+
+	std::string to_string(const std::string& indent=empty_string) const;
+};
+
+typedef std::shared_ptr<QueryPlan> QueryPlanPtr;
+
+/**
+ * A cost-based planner, picking the order in which the clauses of a
+ * search are grounded, and the clause to start with.
+ *
+ * The estimates come from the AtomSpace: the number of Atoms of each
+ * type and arity, from the TypeIndex, and the size of the incoming
+ * sets of the constants in the clauses, by type. A constant held in a
+ * link of type P, with an incoming set of n such links, passes n out
+ * of every count(P) candidates; a variable that is already grounded
+ * passes, on average, arity(P) out of each count(v) candidates, where
+ * count(v) is the number of Atoms that the variable might be. The
+ * estimates assume that the clauses are independent of one-another,
+ * which they are not; but they are good enough to avoid the searches
+ * that start out in the wrong place, and never recover.
+ *
+ * The order is chosen by dynamic programming over the connected,
+ * left-deep orders, for up to `max_exhaustive` clauses, and greedily
+ * for more than that. The cost of an order is the total number of
+ * candidates looked at, for all of the steps.
+ *
+ * Only the mandatory, non-evaluatable clauses are planned. Patterns
+ * with choices, globs or absent clauses are not planned at all; nor
+ * are the small ones, with fewer than `min_clauses` clauses, for which
+ * the greedy choice of the next clause works fine, and planning would
+ * cost more than it saves.
+ */
+class QueryPlanner
+{
+	struct Bound
+	{
+		size_t var;     // Index into _vars
+		double sel;     // Fraction of the clause groundings passed
+		double fanout;  // Candidates per grounding of the variable
+	};
+
+	struct Clause
+	{
+		PatternTermPtr term;
+		double card;    // Groundings, given no variables bound
+		double width;   // Starting points, from the thinnest constant
+		uint64_t vars;  // Bit mask of the variables in it
+		std::vector<Bound> bound;
+	};
+
+	AtomSpace* _as;
+	const Variables& _variables;
+	std::vector<Clause> _clauses;
+	HandleSeq _vars;
+	std::map<Type, double> _type_count;
+
+	double count(Type, Arity);
+	double count(Type);
+	double domain(const Handle&);
+	size_t var_index(const Handle&);
+	bool analyze(const PatternTermPtr&);
+	bool walk(Clause&, const PatternTermPtr&);
+
+	double rows(const Clause&, uint64_t bound) const;
+	double probe(const Clause&, uint64_t bound) const;
+
+	std::vector<size_t> exhaustive(void);
+	std::vector<size_t> greedy(void);
+
+public:
+	QueryPlanner(AtomSpace*, const Variables&);
+
+	static size_t min_clauses;
+	static size_t max_exhaustive;
+
+	/// Return the plan, or nullptr if there is nothing to plan.
+	QueryPlanPtr plan(const PatternTermSeq& clauses);
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_QUERY_PLANNER_H
@@ -24,6 +24,7 @@
 #include <opencog/util/oc_assert.h>
 
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atomspace/AtomSpace.h>
 #include <opencog/query/PatternMatchEngine.h>
 #include "Recognizer.h"
 
@@ -39,6 +40,8 @@ using namespace opencog;
 
 /* ======================================================== */
 
+bool Recognizer::use_index = true;
+
 bool Recognizer::do_search(PatternMatchCallback& pmc, const Handle& top)
 {
 	if (top->is_link())
@@ -78,6 +81,27 @@ bool Recognizer::do_search(PatternMatchCallback& pmc, const Handle& top)
 	return false;
 }
 
+/// Compare each rule that the index turns up with the whole input.
+/// This is where the incoming-set walk in do_search() ends up, too,
+/// after climbing up from the Node that it started at.
+bool Recognizer::index_search(PatternMatchCallback& pmc)
+{
+	RuleIndexPtr rix(_as->get_rule_index());
+	HandleSeq rules;
+	if (nullptr == rix or not rix->lookup(_root->getHandle(), rules))
+		return do_search(pmc, _root->getHandle());
+
+	PatternMatchEngine pme(pmc);
+	pme.set_pattern(*_variables, *_pattern);
+	for (const Handle& h : rules)
+	{
+		dbgprt("Index candidate (%lu):\n%s\n", _cnt++,
+		       h->to_short_string().c_str());
+		if (pme.explore_neighborhood(_root, h, _root)) return true;
+	}
+	return false;
+}
+
 bool Recognizer::perform_search(PatternMatchCallback& pmc)
 {
 	const PatternTermSeq& clauses = _pattern->pmandatory;
@@ -86,7 +110,8 @@ bool Recognizer::perform_search(PatternMatchCallback& pmc)
 	for (const PatternTermPtr& ptm: clauses)
 	{
 		_root = ptm;
-		bool found = do_search(pmc, ptm->getHandle());
+		bool found = use_index ?
+			index_search(pmc) : do_search(pmc, ptm->getHandle());
 		if (found) return true;
 	}
 	return false;
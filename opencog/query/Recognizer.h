@@ -44,6 +44,14 @@ namespace opencog {
  * The is, the constant clause `I love you` can be recognized as
  * grounding two different graphs with variables in them: the graph
  * `I * you` and `I love *`.
+ *
+ * The rules are found with the RuleIndex of the AtomSpace, if it has
+ * one (see AtomSpace::get_rule_index()), and if the input is one that
+ * the index can handle; each rule that the index finds is then checked
+ * in the usual way. Otherwise, the search starts at each Node in the
+ * input, and looks at everything that contains it. The index finds
+ * rules that have no Nodes in common with the input, such as
+ * `(List (Glob "$x"))`; the incoming-set walk does not.
  */
 class Recognizer :
 	public TermMatchMixin,
@@ -58,11 +66,18 @@ class Recognizer :
 		PatternTermPtr _starter_term;
 		size_t _cnt;
 		bool do_search(PatternMatchCallback&, const Handle&);
+		bool index_search(PatternMatchCallback&);
 		bool loose_match(const Handle&, const Handle&);
 
 	public:
 		HandleSet _rules;
 
+		/**
+		 * If set, use the RuleIndex of the AtomSpace, making it if
+		 * need be. On by default.
+		 */
+		static bool use_index;
+
 		Recognizer(AtomSpace* as) :
 		    TermMatchMixin(as),
 		    _cnt(0)
@@ -24,6 +24,7 @@
 #ifndef _OPENCOG_SATISFIER_H
 #define _OPENCOG_SATISFIER_H
 
+#include <typeinfo>
 #include <vector>
 
 #include <opencog/atoms/value/ContainerValue.h>
@@ -79,6 +80,21 @@ class Satisfier :
 
 		// Final pass, if no grounding was found.
 		virtual bool search_finished(bool);
+
+		// As in Implicator: the memo is for the default matching
+		// callbacks only.
+		virtual GroundingMemo* get_grounding_memo(void)
+		{
+			if (typeid(*this) != typeid(Satisfier)) return nullptr;
+			return default_memo();
+		}
+
+	protected:
+		// As in Implicator: a subclass may override the matching
+		// callbacks, which the threads would not call.
+		virtual bool can_search_in_parallel(void) const
+		{ return typeid(*this) == typeid(Satisfier)
+			and not have_continuation(); }
 };
 
 /**
@@ -143,6 +159,17 @@ class SatisfyingSet :
 
 		virtual bool start_search(void);
 		virtual bool search_finished(bool);
+
+		virtual GroundingMemo* get_grounding_memo(void)
+		{
+			if (typeid(*this) != typeid(SatisfyingSet)) return nullptr;
+			return default_memo();
+		}
+
+	protected:
+		virtual bool can_search_in_parallel(void) const
+		{ return typeid(*this) == typeid(SatisfyingSet)
+			and not have_continuation(); }
 };
 
 }; // namespace opencog
@@ -101,6 +101,10 @@ class PMCGroundings : public SatisfyMixin
 		}
 		void push(void) { _cb.push(); }
 		void pop(void) { _cb.pop(); }
+		GroundingMemo* get_grounding_memo(void)
+		{
+			return _cb.get_grounding_memo();
+		}
 		void next_connections(const GroundingMap& var_grounding)
 		{
 			_cb.next_connections(var_grounding);
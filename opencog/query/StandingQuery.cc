@@ -0,0 +1,325 @@
+/*
+ * StandingQuery.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/atoms/value/LinkValue.h>
+
+#include "PatternMatchEngine.h"
+#include "StandingQuery.h"
+
+using namespace opencog;
+
+StandingQuery::StandingQuery(const AtomSpacePtr& as, const Handle& query) :
+	InitiateSearchMixin(as.get()),
+	TermMatchMixin(as.get()),
+	_space(as),
+	_inst(as.get()),
+	_results(createUnisetValue()),
+	_applying(true)
+{
+	Type qt = query->get_type();
+	if (not nameserver().isA(qt, MEET_LINK) and
+	    not nameserver().isA(qt, QUERY_LINK))
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a MeetLink or a QueryLink, got %s",
+			query->to_short_string().c_str());
+
+	_query = as->add_atom(query);
+	_plp = PatternLinkCast(_query)->jit_analyze();
+	if (nameserver().isA(qt, QUERY_LINK))
+		_implicand = _plp->get_implicand();
+
+	const Pattern& pat = _plp->get_pattern();
+	if (1 < _plp->get_components().size() or
+	    0 < _plp->get_virtual().size())
+		throw InvalidParamException(TRACE_INFO,
+			"Standing queries must be connected, and cannot have "
+			"virtual clauses: %s", _query->to_short_string().c_str());
+
+	if (0 < pat.absents.size() or 0 < pat.always.size() or
+	    0 < pat.grouping.size() or pat.pmandatory.empty())
+		throw InvalidParamException(TRACE_INFO,
+			"Standing queries can only have present clauses: %s",
+			_query->to_short_string().c_str());
+
+	for (const PatternTermPtr& clause : pat.pmandatory)
+	{
+		Type ct = clause->getHandle()->get_type();
+		if (clause->hasAnyEvaluatable() or clause->isChoice() or
+		    VARIABLE_NODE == ct or GLOB_NODE == ct)
+			throw InvalidParamException(TRACE_INFO,
+				"Standing queries cannot have evaluatable clauses, "
+				"choices, or lone variables: %s",
+				clause->getHandle()->to_short_string().c_str());
+		_by_type[ct].push_back(clause);
+	}
+}
+
+StandingQuery::~StandingQuery()
+{
+	_space->remove_watcher(this);
+}
+
+/// Watch first, and then search, so that nothing added while the
+/// search runs is missed. Whatever is added in the meantime waits in
+/// `_pending` (`_applying` is set, until start() is done); anything
+/// that the search found already is skipped.
+StandingQueryPtr opencog::createStandingQuery(const AtomSpacePtr& as,
+                                              const Handle& query)
+{
+	StandingQueryPtr sq(std::make_shared<StandingQuery>(as, query));
+	as->add_watcher(sq);
+	sq->start();
+	return sq;
+}
+
+void StandingQuery::start(void)
+{
+	satisfy(_plp);
+	apply();
+}
+
+/* ======================================================== */
+
+void StandingQuery::set_pattern(const Variables& vars, const Pattern& pat)
+{
+	_varseq = vars.varseq;
+	InitiateSearchMixin::set_pattern(vars, pat);
+	TermMatchMixin::set_pattern(vars, pat);
+}
+
+ValuePtr StandingQuery::make_result(const HandleSeq& key,
+                                    const GroundingMap& var_soln)
+{
+	if (_implicand.empty())
+	{
+		if (1 == key.size()) return key[0];
+		return createLinkValue(ValueSeq(key.begin(), key.end()));
+	}
+
+	// As in RewriteMixin::propose_grounding(). Adding the rewrites to
+	// the AtomSpace comes back to atom_added(); they wait in line.
+	try
+	{
+		ValueSeq vs;
+		for (const Handle& himp : _implicand)
+		{
+			ValuePtr v(_inst.instantiate(himp, var_soln, true));
+			if (nullptr == v) continue;
+			if (v->is_atom())
+				v = _space->add_atom(HandleCast(v));
+			vs.emplace_back(v);
+		}
+		if (1 == _implicand.size())
+			return vs.empty() ? nullptr : vs[0];
+		return createLinkValue(vs);
+	}
+	catch (const SilentException& ex) {}
+	return nullptr;
+}
+
+bool StandingQuery::propose_grounding(const GroundingMap& var_soln,
+                                      const GroundingMap& term_soln)
+{
+	HandleSeq key;
+	key.reserve(_varseq.size());
+	for (const Handle& hv : _varseq)
+	{
+		auto it = var_soln.find(hv);
+		key.push_back(var_soln.end() == it ? hv : it->second);
+	}
+
+	// Found before, starting at some other clause, or some other time.
+	if (_groundings.end() != _groundings.find(key)) return false;
+
+	Grounding g;
+	for (const auto& tg : term_soln)
+		if (g.support.end() ==
+		    std::find(g.support.begin(), g.support.end(), tg.second))
+			g.support.push_back(tg.second);
+	g.result = make_result(key, var_soln);
+
+	std::lock_guard<std::mutex> lck(_res_mtx);
+	auto ins = _groundings.emplace(std::move(key), std::move(g));
+	const HandleSeq* kp = &ins.first->first;
+	const Grounding& gr = ins.first->second;
+	for (const Handle& h : gr.support)
+		_supports[h].insert(kp);
+
+	if (gr.result and 1 == ++_counts[gr.result])
+		_results->add(gr.result);
+
+	// Keep looking; we want all of them.
+	return false;
+}
+
+/// Drop the grounding, and its result, if nothing else supports it.
+void StandingQuery::forget(const HandleSeq* kp)
+{
+	auto it = _groundings.find(*kp);
+	for (const Handle& h : it->second.support)
+	{
+		auto st = _supports.find(h);
+		st->second.erase(kp);
+		if (st->second.empty()) _supports.erase(st);
+	}
+
+	const ValuePtr& result(it->second.result);
+	if (result)
+	{
+		auto ct = _counts.find(result);
+		if (0 == --ct->second)
+		{
+			_results->erase(result);
+			_counts.erase(ct);
+		}
+	}
+	_groundings.erase(it);
+}
+
+/* ======================================================== */
+
+/// Start the search at the clause, grounded by the Atom; the same as
+/// one turn of InitiateSearchMixin::search_loop().
+void StandingQuery::seed(const PatternTermPtr& clause, const Handle& h)
+{
+	_root = clause;
+	_starter_term = clause;
+	_plan = nullptr;
+	while (0 < _issued_stack.size()) _issued_stack.pop();
+	_issued.clear();
+	_issued.insert(clause);
+
+	PatternMatchEngine pme(*this);
+	pme.set_pattern(*_variables, *_pattern);
+	pme.explore_neighborhood(clause, h, clause);
+}
+
+void StandingQuery::added(const Handle& h)
+{
+	auto bt = _by_type.find(h->get_type());
+	if (_by_type.end() == bt) return;
+
+	// Gone again, before we got to it.
+	if (nullptr == _space->get_atom(h)) return;
+
+	for (const PatternTermPtr& clause : bt->second)
+		seed(clause, h);
+}
+
+void StandingQuery::extracted(const Handle& h)
+{
+	std::lock_guard<std::mutex> lck(_res_mtx);
+	auto st = _supports.find(h);
+	if (_supports.end() == st) return;
+
+	// forget() edits the set we would be looping over.
+	std::vector<const HandleSeq*> gone(st->second.begin(), st->second.end());
+	for (const HandleSeq* kp : gone)
+		forget(kp);
+}
+
+void StandingQuery::cleared(void)
+{
+	std::lock_guard<std::mutex> lck(_res_mtx);
+	_groundings.clear();
+	_supports.clear();
+	_counts.clear();
+	_results->clear();
+}
+
+/* ======================================================== */
+
+void StandingQuery::atom_added(const Handle& h)
+{
+	change({h, true});
+}
+
+void StandingQuery::atom_extracted(const Handle& h)
+{
+	change({h, false});
+}
+
+void StandingQuery::atoms_cleared(void)
+{
+	change({Handle::UNDEFINED, false});
+}
+
+/// Changes are applied one at a time, in the order that they were
+/// made. A change made while another is being applied waits its turn:
+/// either it came from another thread, or it came from this one, from
+/// the rewrite of a grounding, in the middle of a search.
+void StandingQuery::change(Change&& ch)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_pending.emplace_back(std::move(ch));
+		if (_applying) return;
+		_applying = true;
+	}
+	apply();
+}
+
+void StandingQuery::apply(void)
+{
+	while (true)
+	{
+		Change ch;
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			if (_pending.empty())
+			{
+				_applying = false;
+				return;
+			}
+			ch = std::move(_pending.front());
+			_pending.pop_front();
+		}
+
+		if (nullptr == ch.atom) cleared();
+		else if (ch.added) added(ch.atom);
+		else extracted(ch.atom);
+	}
+}
+
+/* ======================================================== */
+
+ValueSeq StandingQuery::current(void) const
+{
+	std::lock_guard<std::mutex> lck(_res_mtx);
+	ValueSeq vs;
+	vs.reserve(_counts.size());
+	for (const auto& ct : _counts)
+		vs.push_back(ct.first);
+	return vs;
+}
+
+size_t StandingQuery::num_groundings(void) const
+{
+	std::lock_guard<std::mutex> lck(_res_mtx);
+	return _groundings.size();
+}
+
+/* ===================== END OF FILE ===================== */
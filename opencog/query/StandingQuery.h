@@ -0,0 +1,175 @@
+/*
+ * StandingQuery.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_STANDING_QUERY_H
+#define _OPENCOG_STANDING_QUERY_H
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <opencog/atoms/execution/Instantiator.h>
+#include <opencog/atoms/value/UnisetValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atomspace/AtomWatcher.h>
+
+#include <opencog/query/InitiateSearchMixin.h>
+#include <opencog/query/SatisfyMixin.h>
+#include <opencog/query/TermMatchMixin.h>
+
+namespace opencog {
+
+class StandingQuery;
+typedef std::shared_ptr<StandingQuery> StandingQueryPtr;
+
+/**
+ * A MeetLink or QueryLink whose results are kept up to date, as Atoms
+ * are added to, and extracted from the AtomSpace, without searching
+ * the whole AtomSpace again.
+ *
+ * The query is run once, in full, when it is created. After that,
+ * each change is propagated on its own, Rete-style:
+ *
+ * -- When an Atom is added, the only new groundings are those that
+ *    have that Atom as the grounding of one of the clauses (a new
+ *    grounding of a variable is always inside a new clause grounding).
+ *    So the search is started at each clause of that type, with the
+ *    new Atom as its grounding, and the rest of the clauses are joined
+ *    on to it, through the incoming sets, as in any other search.
+ *
+ * -- Each grounding remembers the clause groundings that support it.
+ *    When an Atom is extracted, the groundings that it supported are
+ *    dropped, and so are the results that no longer have any grounding.
+ *
+ * Thus, the work done for each change depends on the neighborhood of
+ * the changed Atom, and not on the size of the AtomSpace. The partial
+ * matches are not stored: the incoming sets already index them.
+ *
+ * The results are placed in an (open) UnisetValue, as they appear,
+ * and taken back out when they go away. A consumer may take them out
+ * as they arrive, with remove(); or it may leave them be, and look at
+ * them with size() and current(). A result that was taken out, and is
+ * found again, is not put back, as long as it never went away.
+ *
+ * For a QueryLink, the rewrites are added to the AtomSpace, as usual.
+ * If they match the query themselves, they are propagated in turn.
+ *
+ * Only patterns made of plain, present clauses can be kept up to date
+ * in this way: adding an Atom can make an AbsentLink or an AlwaysLink
+ * false, and an evaluatable clause can depend on anything at all. The
+ * pattern must be connected, and no clause may be a lone variable.
+ * Other patterns are rejected with an InvalidParamException.
+ *
+ * Changes are seen only if they are made in the given AtomSpace, and
+ * not in any of the AtomSpaces underneath it. When several threads
+ * change the AtomSpace at once, the changes are applied one at a time,
+ * by whichever thread is already applying them. Thus, a change made by
+ * one thread may show up in the results a little after its add_atom()
+ * or extract_atom() returns.
+ */
+class StandingQuery :
+	public InitiateSearchMixin,
+	public TermMatchMixin,
+	public SatisfyMixin,
+	public AtomWatcher
+{
+	friend StandingQueryPtr createStandingQuery(const AtomSpacePtr&,
+	                                            const Handle&);
+public:
+	StandingQuery(const AtomSpacePtr&, const Handle&);
+	virtual ~StandingQuery();
+
+	/** The results, kept up to date. */
+	const UnisetValuePtr& get_results(void) const { return _results; }
+
+	/** A copy of all of the current results. */
+	ValueSeq current(void) const;
+
+	/** The number of groundings behind the current results. */
+	size_t num_groundings(void) const;
+
+	virtual void set_pattern(const Variables&, const Pattern&);
+	virtual bool propose_grounding(const GroundingMap&,
+	                               const GroundingMap&);
+
+	virtual void atom_added(const Handle&);
+	virtual void atom_extracted(const Handle&);
+	virtual void atoms_cleared(void);
+
+private:
+	AtomSpacePtr _space;
+	Handle _query;
+	PatternLinkPtr _plp;
+	HandleSeq _varseq;
+	HandleSeq _implicand;
+	Instantiator _inst;
+	UnisetValuePtr _results;
+
+	// The clauses, by the type of their root.
+	std::unordered_map<Type, PatternTermSeq> _by_type;
+
+	// Each grounding, by the groundings of the variables, in the
+	// order of `_varseq`; and the groundings supported by each clause
+	// grounding. The pointers point at the keys of `_groundings`.
+	struct Grounding
+	{
+		HandleSeq support;
+		ValuePtr result;
+	};
+	std::unordered_map<HandleSeq, Grounding> _groundings;
+	std::unordered_map<Handle, std::unordered_set<const HandleSeq*>> _supports;
+
+	// The number of groundings behind each result.
+	std::unordered_map<ValuePtr, size_t> _counts;
+	mutable std::mutex _res_mtx;
+
+	// The changes waiting to be applied; see apply().
+	struct Change
+	{
+		Handle atom;
+		bool added;
+	};
+	std::mutex _mtx;
+	std::deque<Change> _pending;
+	bool _applying;
+
+	void start(void);
+	void change(Change&&);
+	void apply(void);
+	void added(const Handle&);
+	void extracted(const Handle&);
+	void cleared(void);
+	void seed(const PatternTermPtr&, const Handle&);
+	ValuePtr make_result(const HandleSeq&, const GroundingMap&);
+	void forget(const HandleSeq*);
+};
+
+/**
+ * Run the query, and keep its results up to date from here on, for
+ * as long as the StandingQuery is held on to.
+ */
+StandingQueryPtr createStandingQuery(const AtomSpacePtr&, const Handle&);
+
+}; // namespace opencog
+
+#endif // _OPENCOG_STANDING_QUERY_H
@@ -101,6 +101,10 @@ class TermMatchMixin : public virtual PatternMatchCallback
 
 		bool optionals_present(void) { return _optionals_present; }
 
+		// For searches that were split across threads, each with its
+		// own TermMatchMixin; see InitiateSearchMixin::parallel_search().
+		void set_optionals_present(void) { _optionals_present = true; }
+
 	protected:
 		NameServer& _nameserver;
 